@@ -1,6 +1,29 @@
 #include <iostream>
 #include <string>
 #include <cstdlib>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <set>
+#include <deque>
+#include <queue>
+#include <limits>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
 
 // Para generar documentación de código con doxygen
 
@@ -33,6 +56,8 @@ class Componente {
     float cargaProcesamiento;
 
     public:
+    virtual ~Componente() = default;
+
     /**
      * @brief Metodo para mostrar estado del componente.
      * 
@@ -43,6 +68,55 @@ class Componente {
 
     }
 
+    /**
+     * @brief Actualiza el consumo y la carga con valores medidos.
+     * 
+     * @param _energiaConsumida 
+     * @param _cargaProcesamiento 
+     */
+    void actualizarConsumo(float _energiaConsumida, float _cargaProcesamiento) {
+
+        energiaConsumida   = _energiaConsumida;
+        cargaProcesamiento = _cargaProcesamiento;
+
+    }
+
+    /**
+     * @brief Actualiza solo la carga de procesamiento.
+     * 
+     * @param _cargaProcesamiento 
+     */
+    void setCargaProcesamiento(float _cargaProcesamiento) {
+
+        cargaProcesamiento = _cargaProcesamiento;
+
+    }
+
+    /**
+     * @brief Actualiza solo la energia consumida.
+     * 
+     * @param _energiaConsumida 
+     */
+    void setEnergiaConsumida(float _energiaConsumida) {
+
+        energiaConsumida = _energiaConsumida;
+
+    }
+
+    /**
+     * @brief Energia consumida en la ultima medicion.
+     * 
+     * @return float Watt.
+     */
+    float getEnergiaConsumida() const { return energiaConsumida; }
+
+    /**
+     * @brief Carga de procesamiento en la ultima medicion.
+     * 
+     * @return float Porcentaje entre 0 y 100.
+     */
+    float getCargaProcesamiento() const { return cargaProcesamiento; }
+
 };
 
 /**
@@ -60,7 +134,7 @@ class Procesamiento : public Componente {
      * @brief Sobreescribe el metodo mostrar estado del componente.
      * 
      */
-    virtual void mostrarEstado() override {
+    virtual void mostrarEstado() const override {
 
         Componente::mostrarEstado();
 
@@ -68,6 +142,33 @@ class Procesamiento : public Componente {
 
     }
 
+    /**
+     * @brief Actualiza la frecuencia y la cantidad de cores con valores medidos.
+     * 
+     * @param _frecuencia 
+     * @param _cores 
+     */
+    void actualizarFrecuencia(float _frecuencia, int _cores) {
+
+        frecuencia = _frecuencia;
+        cores      = _cores;
+
+    }
+
+    /**
+     * @brief Frecuencia de trabajo.
+     * 
+     * @return float GHz.
+     */
+    float getFrecuencia() const { return frecuencia; }
+
+    /**
+     * @brief Cantidad de cores.
+     * 
+     * @return int
+     */
+    int getCores() const { return cores; }
+
 };
 
 /**
@@ -80,13 +181,15 @@ class Almacenamiento : public Componente {
     float capacidadAlmacenamiento;
     float velocidadAcceso;
     std::string tipoInterfaz;
+    float iops = 0;
+    float latenciaPromedio = 0;
 
     public:
     /**
      * @brief Sobreescribe el metodo mostrar estado del componente.
      * 
      */
-    virtual void mostrarEstado() override {
+    virtual void mostrarEstado() const override {
 
         Componente::mostrarEstado();
 
@@ -94,6 +197,56 @@ class Almacenamiento : public Componente {
 
     }
 
+    /**
+     * @brief Actualiza las metricas de entrada/salida con valores medidos.
+     * 
+     * @param _velocidadAcceso Rendimiento en MB/s.
+     * @param _iops Operaciones por segundo.
+     * @param _latenciaPromedio Latencia promedio por operacion en ms.
+     */
+    void actualizarES(float _velocidadAcceso, float _iops, float _latenciaPromedio) {
+
+        velocidadAcceso  = _velocidadAcceso;
+        iops             = _iops;
+        latenciaPromedio = _latenciaPromedio;
+
+    }
+
+    /**
+     * @brief Capacidad del dispositivo.
+     * 
+     * @return float GB.
+     */
+    float getCapacidadAlmacenamiento() const { return capacidadAlmacenamiento; }
+
+    /**
+     * @brief Rendimiento de lectura y escritura; en un SSHD es la velocidad efectiva.
+     * 
+     * @return float MB/s.
+     */
+    float getVelocidadAcceso() const { return velocidadAcceso; }
+
+    /**
+     * @brief Operaciones de entrada/salida por segundo medidas.
+     * 
+     * @return float
+     */
+    float getIops() const { return iops; }
+
+    /**
+     * @brief Latencia promedio por operacion medida.
+     * 
+     * @return float ms.
+     */
+    float getLatenciaPromedio() const { return latenciaPromedio; }
+
+    /**
+     * @brief Interfaz de conexion del dispositivo.
+     * 
+     * @return const std::string&
+     */
+    const std::string& getTipoInterfaz() const { return tipoInterfaz; }
+
 };
 
 /**
@@ -140,12 +293,26 @@ class CPU : public Procesamiento {
      * @brief Sobreescribe el metodo mostrar estado del componente.
      * 
      */
-    void mostrarEstado() override {
+    void mostrarEstado() const override {
 
         std::cout << "CPU - Numero de Procesador: " << numeroProcesador << ", Cache L3: " << cacheL3 << " MB" << std::endl;
 
     }
 
+    /**
+     * @brief Numero de procesador.
+     * 
+     * @return int
+     */
+    int getNumeroProcesador() const { return numeroProcesador; }
+
+    /**
+     * @brief Tamano de la cache L3.
+     * 
+     * @return int MB.
+     */
+    int getCacheL3() const { return cacheL3; }
+
 };
 
 /**
@@ -189,19 +356,26 @@ class GPU : public Procesamiento {
      * @brief Sobreescribe el metodo mostrar estado del componente.
      * 
      */
-    void mostrarEstado() override {
+    void mostrarEstado() const override {
 
         std::cout << "GPU - Ancho de Banda: " << memoria << " GB/s" << std::endl;
 
     }
 
+    /**
+     * @brief Ancho de banda de memoria.
+     * 
+     * @return float GB/s.
+     */
+    float getMemoria() const { return memoria; }
+
 };
 
 /**
  * @brief Clase hija de Almacenamiento.
  * 
  */
-class HDD : public Almacenamiento {
+class HDD : public virtual Almacenamiento {
 
     private:
     int rpm;
@@ -243,19 +417,33 @@ class HDD : public Almacenamiento {
      * @brief Sobreescribe el metodo mostrar estado del componente.
      * 
      */
-    void mostrarEstado() override {
+    void mostrarEstado() const override {
 
         std::cout << "Velocidad de Rotacion: " << rpm << " rpm, Cache: " << memoriaCache << " MB" << std::endl;
 
     }
 
+    /**
+     * @brief Velocidad de rotacion.
+     * 
+     * @return int rpm.
+     */
+    int getRpm() const { return rpm; }
+
+    /**
+     * @brief Tamano de la cache del disco.
+     * 
+     * @return int MB.
+     */
+    int getMemoriaCache() const { return memoriaCache; }
+
 };
 
 /**
  * @brief Clase hija de Almacenamiento.
  * 
  */
-class SSD : public Almacenamiento {
+class SSD : public virtual Almacenamiento {
 
     private:
     std::string tipoMemoria;
@@ -294,34 +482,246 @@ class SSD : public Almacenamiento {
      * @brief Sobreescribe el metodo mostrar estado del componente.
      * 
      */
-    void mostrarEstado() override {
+    void mostrarEstado() const override {
 
         std::cout << "Tipo de Memoria: " << tipoMemoria << std::endl;
 
     }
 
+    /**
+     * @brief Tipo de memoria flash.
+     * 
+     * @return const std::string&
+     */
+    const std::string& getTipoMemoria() const { return tipoMemoria; }
+
+};
+
+/**
+ * @brief Politicas de reemplazo del nivel de cache de un SSHD.
+ * 
+ */
+enum PoliticaCache {
+    CACHE_LRU,
+    CACHE_ARC
+};
+
+/**
+ * @brief Cache de bloques con reemplazo LRU o ARC (Megiddo y Modha), usada para simular el nivel SSD de un SSHD.
+ * 
+ * Con LRU solo se usa la lista t1. Con ARC, t1 guarda los bloques vistos una vez y t2 los vistos al menos
+ * dos veces; b1 y b2 son listas fantasma (solo identificadores) de lo expulsado de cada una, y el objetivo p
+ * se adapta segun en cual de ellas se producen los aciertos. Todas las operaciones son O(1).
+ */
+class CacheBloques {
+
+    private:
+    enum Lista : uint8_t { T1, T2, B1, B2 };
+
+    struct Entrada {
+        Lista lista;
+        std::list<uint64_t>::iterator posicion;
+    };
+
+    PoliticaCache politica;
+    size_t capacidad;
+    size_t objetivo;
+    std::list<uint64_t> listas[4];
+    std::unordered_map<uint64_t, Entrada> entradas;
+    uint64_t aciertos;
+    uint64_t accesos;
+
+    /**
+     * @brief Mueve un bloque al frente (mas reciente) de una lista.
+     * 
+     * @param entrada 
+     * @param destino 
+     */
+    void mover(Entrada& entrada, Lista destino) {
+
+        listas[destino].splice(listas[destino].begin(), listas[entrada.lista], entrada.posicion);
+        entrada.lista = destino;
+        entrada.posicion = listas[destino].begin();
+
+    }
+
+    /**
+     * @brief Quita el bloque menos reciente de una lista y lo olvida.
+     * 
+     * @param lista 
+     */
+    void descartarUltimo(Lista lista) {
+
+        entradas.erase(listas[lista].back());
+        listas[lista].pop_back();
+
+    }
+
+    /**
+     * @brief Expulsa un bloque de t1 o t2 hacia su lista fantasma, segun el objetivo p.
+     * 
+     * @param enB2 Si el bloque que provoca el reemplazo estaba en b2.
+     */
+    void reemplazar(bool enB2) {
+
+        if (listas[T1].size() + listas[T2].size() < capacidad) return;
+        Lista origen = !listas[T1].empty() && (listas[T1].size() > objetivo || (enB2 && listas[T1].size() == objetivo)) ? T1 : T2;
+        if (listas[origen].empty()) origen = origen == T1 ? T2 : T1;
+        uint64_t victima = listas[origen].back();
+        mover(entradas[victima], origen == T1 ? B1 : B2);
+
+    }
+
+    /**
+     * @brief Inserta un bloque nuevo al frente de una lista.
+     * 
+     * @param bloque 
+     * @param lista 
+     */
+    void insertar(uint64_t bloque, Lista lista) {
+
+        listas[lista].push_front(bloque);
+        entradas[bloque] = Entrada{lista, listas[lista].begin()};
+
+    }
+
+    bool accederLRU(uint64_t bloque) {
+
+        auto it = entradas.find(bloque);
+        if (it != entradas.end()) {
+            mover(it->second, T1);
+            return true;
+        }
+        if (listas[T1].size() >= capacidad) descartarUltimo(T1);
+        insertar(bloque, T1);
+        return false;
+
+    }
+
+    bool accederARC(uint64_t bloque) {
+
+        auto it = entradas.find(bloque);
+        if (it != entradas.end() && (it->second.lista == T1 || it->second.lista == T2)) {
+            mover(it->second, T2);
+            return true;
+        }
+        if (it != entradas.end() && it->second.lista == B1) {
+            size_t delta = std::max<size_t>(listas[B2].size() / std::max<size_t>(listas[B1].size(), 1), 1);
+            objetivo = std::min(capacidad, objetivo + delta);
+            reemplazar(false);
+            mover(it->second, T2);
+            return false;
+        }
+        if (it != entradas.end() && it->second.lista == B2) {
+            size_t delta = std::max<size_t>(listas[B1].size() / std::max<size_t>(listas[B2].size(), 1), 1);
+            objetivo = objetivo > delta ? objetivo - delta : 0;
+            reemplazar(true);
+            mover(it->second, T2);
+            return false;
+        }
+
+        size_t l1 = listas[T1].size() + listas[B1].size();
+        size_t total = l1 + listas[T2].size() + listas[B2].size();
+        if (l1 >= capacidad) {
+            if (listas[T1].size() < capacidad) {
+                descartarUltimo(B1);
+                reemplazar(false);
+            } else {
+                descartarUltimo(T1);
+            }
+        } else if (total >= capacidad) {
+            if (total >= 2 * capacidad) descartarUltimo(B2);
+            reemplazar(false);
+        }
+        insertar(bloque, T1);
+        return false;
+
+    }
+
+    public:
+    /**
+     * @brief Constructor.
+     * 
+     * @param _capacidad Cantidad de bloques que caben en la cache.
+     * @param _politica 
+     */
+    CacheBloques(size_t _capacidad, PoliticaCache _politica) : politica(_politica), capacidad(std::max<size_t>(_capacidad, 1)), objetivo(0), aciertos(0), accesos(0) {
+
+        entradas.reserve(2 * capacidad);
+
+    }
+
+    /**
+     * @brief Registra un acceso a un bloque, cargandolo en la cache si no estaba.
+     * 
+     * @param bloque 
+     * @return bool true si fue un acierto.
+     */
+    bool acceder(uint64_t bloque) {
+
+        bool acierto = politica == CACHE_LRU ? accederLRU(bloque) : accederARC(bloque);
+        accesos++;
+        aciertos += acierto;
+        return acierto;
+
+    }
+
+    size_t cantidadBloques() const { return listas[T1].size() + listas[T2].size(); }
+    uint64_t getAccesos() const { return accesos; }
+    double tasaAciertos() const { return accesos > 0 ? static_cast<double>(aciertos) / accesos : 0.0; }
+
 };
 
 /**
- * @brief Clase hija de HDD y SSD.
+ * @brief Disco hibrido: un nivel SSD que cachea los bloques calientes sobre un nivel HDD.
  * 
+ * HDD y SSD heredan virtualmente de Almacenamiento, por lo que un SSHD tiene un unico estado de Componente y
+ * de Almacenamiento compartido por ambas partes. velocidadAcceso es la velocidad efectiva del conjunto, que
+ * se deriva de la tasa de aciertos del nivel SSD; las velocidades de cada nivel se guardan por separado.
  */
 class SSHD : public HDD, public SSD {
 
+    private:
+    float velocidadDisco;
+    float velocidadCache;
+    float capacidadCache;
+    float tasaAciertos;
+
     public:
     /**
-     * @brief Constructor de la clase SSHD con parametros sin implementacion.
+     * @brief Constructor de la clase SSHD con parametros, con un nivel SSD de 8 GB a 500 MB/s.
      * 
      * @param _energiaConsumida 
      * @param _cargaProcesamiento 
      * @param _capacidadAlmacenamiento 
-     * @param _velocidadAcceso 
+     * @param _velocidadAcceso Velocidad del nivel HDD en MB/s.
+     * @param _tipoInterfaz 
+     * @param _rpm 
+     * @param _memoriaCache 
+     * @param _tipoMemoria 
+     */
+    SSHD(float _energiaConsumida, float _cargaProcesamiento, float _capacidadAlmacenamiento, float _velocidadAcceso, std::string _tipoInterfaz, int _rpm, int _memoriaCache, std::string _tipoMemoria) : SSHD(_energiaConsumida, _cargaProcesamiento, _capacidadAlmacenamiento, _velocidadAcceso, _tipoInterfaz, _rpm, _memoriaCache, _tipoMemoria, 500, 8){}
+
+    /**
+     * @brief Constructor de la clase SSHD con parametros, indicando el nivel SSD.
+     * 
+     * @param _energiaConsumida 
+     * @param _cargaProcesamiento 
+     * @param _capacidadAlmacenamiento 
+     * @param _velocidadAcceso Velocidad del nivel HDD en MB/s.
      * @param _tipoInterfaz 
      * @param _rpm 
      * @param _memoriaCache 
      * @param _tipoMemoria 
+     * @param _velocidadCache Velocidad del nivel SSD en MB/s.
+     * @param _capacidadCache Capacidad del nivel SSD en GB.
      */
-    SSHD(float _energiaConsumida, float _cargaProcesamiento, float _capacidadAlmacenamiento, float _velocidadAcceso, std::string _tipoInterfaz, int _rpm, int _memoriaCache, std::string _tipoMemoria) : HDD(_energiaConsumida, _cargaProcesamiento, _capacidadAlmacenamiento, _velocidadAcceso, _tipoInterfaz, _rpm, _memoriaCache), SSD(_energiaConsumida, _cargaProcesamiento, _capacidadAlmacenamiento, _velocidadAcceso, _tipoInterfaz, _tipoMemoria){}
+    SSHD(float _energiaConsumida, float _cargaProcesamiento, float _capacidadAlmacenamiento, float _velocidadAcceso, std::string _tipoInterfaz, int _rpm, int _memoriaCache, std::string _tipoMemoria, float _velocidadCache, float _capacidadCache) : HDD(_energiaConsumida, _cargaProcesamiento, _capacidadAlmacenamiento, _velocidadAcceso, _tipoInterfaz, _rpm, _memoriaCache), SSD(_energiaConsumida, _cargaProcesamiento, _capacidadAlmacenamiento, _velocidadAcceso, _tipoInterfaz, _tipoMemoria) {
+        velocidadDisco = _velocidadAcceso;
+        velocidadCache = _velocidadCache;
+        capacidadCache = _capacidadCache;
+        tasaAciertos   = 0;
+    }
 
     /**
      * @brief Metodo que muestra el metodo estadoAlmacenamiento implementado en la clase SSD.
@@ -337,43 +737,3072 @@ class SSHD : public HDD, public SSD {
      * @brief Sobreescribe el metodo mostrar estado del componente.
      * 
      */
-    void mostrarEstado() override {
+    void mostrarEstado() const override {
 
         HDD::mostrarEstado();
         SSD::mostrarEstado();
+        std::cout << "Nivel SSD: " << capacidadCache << " GB a " << velocidadCache << " MB/s, Nivel HDD: " << velocidadDisco << " MB/s, Aciertos: " << tasaAciertos * 100 << "%" << std::endl;
+
+    }
+
+    /**
+     * @brief Fija la tasa de aciertos del nivel SSD y recalcula la velocidad efectiva.
+     * 
+     * Cada MB se lee del SSD con probabilidad h y del HDD con probabilidad 1 - h, asi que el tiempo por MB
+     * es h / velocidadCache + (1 - h) / velocidadDisco y la velocidad efectiva es su inverso.
+     * 
+     * @param _tasaAciertos Entre 0 y 1.
+     */
+    void setTasaAciertos(float _tasaAciertos) {
+
+        tasaAciertos = _tasaAciertos;
+        velocidadAcceso = 1.0f / (tasaAciertos / velocidadCache + (1.0f - tasaAciertos) / velocidadDisco);
+
+    }
+
+    /**
+     * @brief Reproduce una traza de bloques sobre el nivel SSD y actualiza la tasa de aciertos y la velocidad efectiva.
+     * 
+     * @param bloques Identificadores de bloque en orden de acceso.
+     * @param politica 
+     * @param tamanoBloqueKB 
+     * @return double Tasa de aciertos.
+     */
+    double simularTraza(const std::vector<uint64_t>& bloques, PoliticaCache politica, uint32_t tamanoBloqueKB = 64) {
+
+        size_t capacidadBloques = static_cast<size_t>(capacidadCache * 1024.0f * 1024.0f / tamanoBloqueKB);
+        CacheBloques cache(capacidadBloques, politica);
+        for (uint64_t bloque : bloques) cache.acceder(bloque);
+        setTasaAciertos(static_cast<float>(cache.tasaAciertos()));
+        return tasaAciertos;
 
     }
+
+    /**
+     * @brief Velocidad del nivel HDD.
+     * 
+     * @return float MB/s.
+     */
+    float getVelocidadDisco() const { return velocidadDisco; }
+
+    /**
+     * @brief Velocidad del nivel SSD.
+     * 
+     * @return float MB/s.
+     */
+    float getVelocidadCache() const { return velocidadCache; }
+
+    /**
+     * @brief Capacidad del nivel SSD.
+     * 
+     * @return float GB.
+     */
+    float getCapacidadCache() const { return capacidadCache; }
+
+    /**
+     * @brief Fraccion de accesos servidos por el nivel SSD.
+     * 
+     * @return float Entre 0 y 1.
+     */
+    float getTasaAciertos() const { return tasaAciertos; }
+
 };
 
 /**
- * @brief Función principal.
+ * @brief Genera una traza de bloques con un conjunto caliente sesgado, accesos aleatorios y recorridos secuenciales.
+ * 
+ * @param accesos 
+ * @param bloquesDisco Cantidad total de bloques del disco.
+ * @param bloquesCalientes Tamano del conjunto caliente.
+ * @return std::vector<uint64_t> 
+ */
+std::vector<uint64_t> generarTrazaBloques(size_t accesos, uint64_t bloquesDisco, uint64_t bloquesCalientes) {
+
+    std::vector<uint64_t> traza;
+    traza.reserve(accesos);
+    std::mt19937_64 generador(11);
+    std::uniform_real_distribution<double> uniforme(0.0, 1.0);
+    while (traza.size() < accesos) {
+        double u = uniforme(generador);
+        if (u < 0.00002) {
+            // Recorrido secuencial largo (respaldo, indexacion) que no se vuelve a leer.
+            uint64_t inicio = generador() % bloquesDisco;
+            for (uint64_t b = 0; b < bloquesCalientes / 8 && traza.size() < accesos; b++) traza.push_back((inicio + b) % bloquesDisco);
+        } else if (u < 0.85) {
+            double v = uniforme(generador);
+            traza.push_back(static_cast<uint64_t>(v * v * v * bloquesCalientes));
+        } else {
+            traza.push_back(generador() % bloquesDisco);
+        }
+    }
+    return traza;
+
+}
+
+/**
+ * @brief Compara LRU y ARC como politica del nivel SSD de un SSHD sobre la misma traza.
  * 
- * Crea y muestra el estado de varios componentes de procesamiento y almacenamiento.
+ * @param accesos 
+ */
+void simularSSHD(size_t accesos) {
+
+    const uint32_t BLOQUE_KB = 64;
+    SSHD sshd(9, 50, 2000, 200, "SATA", 7200, 64, "MLC", 500, 8);
+    uint64_t bloquesDisco = static_cast<uint64_t>(sshd.getCapacidadAlmacenamiento()) * 1024 * 1024 / BLOQUE_KB;
+    uint64_t bloquesCache = static_cast<uint64_t>(sshd.getCapacidadCache()) * 1024 * 1024 / BLOQUE_KB;
+    std::vector<uint64_t> traza = generarTrazaBloques(accesos, bloquesDisco, bloquesCache * 3 / 2);
+    std::cout << "Traza: " << traza.size() << " accesos de " << BLOQUE_KB << " KB, nivel SSD de " << bloquesCache << " bloques\n";
+
+    const PoliticaCache POLITICAS[] = {CACHE_LRU, CACHE_ARC};
+    const char* const NOMBRES[] = {"LRU", "ARC"};
+    for (int i = 0; i < 2; i++) {
+        auto inicio = std::chrono::steady_clock::now();
+        double aciertos = sshd.simularTraza(traza, POLITICAS[i], BLOQUE_KB);
+        auto fin = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(fin - inicio).count() / traza.size();
+        std::cout << NOMBRES[i] << ": aciertos " << aciertos * 100 << "%, velocidad efectiva " << sshd.getVelocidadAcceso()
+                  << " MB/s (" << ns << " ns/acceso)\n";
+    }
+    std::cout << "sizeof(SSHD): " << sizeof(SSHD) << " bytes\n";
+
+}
+
+/*******************************************
+ * Telemetria en vivo de la CPU            *
+ *******************************************/
+
+/**
+ * @brief Lee un entero sin signo en base 10 avanzando el puntero, saltando los espacios previos.
  * 
- * @return void
+ * @param p Posicion actual, queda despues del ultimo digito leido.
+ * @param fin 
+ * @return uint64_t 
  */
-int main() {
-    CPU cpu(70, 40, 3.5, 8, 1, 16);
-    GPU gpu(130, 60, 1.5, 2048, 448);
-    HDD hdd(9, 30, 1000, 150, "SATA", 7200, 64);
-    SSD ssd(2.5, 20, 500, 550, "NVMe", "TLC");
-    SSHD sshd(9, 50, 2000, 200, "SATA", 7200, 64, "MLC");
+inline uint64_t leerEnteroTexto(const char*& p, const char* fin) {
 
-    std::cout << "Estado del CPU: " << "\n";
-    cpu.estadoProcesamiento();
-    cpu.mostrarEstado();
-    std::cout << "\nEstado de la GPU: " << "\n";
-    gpu.estadoProcesamiento();
-    gpu.mostrarEstado();
-    std::cout << "\nEstado del HDD: " << "\n";
-    hdd.estadoAlmacenamiento();
-    hdd.mostrarEstado();
-    std::cout << "\nEstado del SSD: " << "\n";
-    ssd.estadoAlmacenamiento();
-    ssd.mostrarEstado();
-    std::cout << "\nEstado del SSHD: " << "\n";
-    sshd.estadoAlmacenamiento();
-    sshd.mostrarEstado();
+    while (p < fin && (*p == ' ' || *p == '\t')) ++p;
+    uint64_t valor = 0;
+    while (p < fin && *p >= '0' && *p <= '9') {
+        valor = valor * 10 + static_cast<uint64_t>(*p - '0');
+        ++p;
+    }
+    return valor;
+
+}
+
+/**
+ * @brief Lee un archivo de sysfs que contiene un unico entero, sin reabrirlo.
+ * 
+ * @param fd Descriptor abierto del archivo.
+ * @param valor 
+ * @return bool false si la lectura falla.
+ */
+inline bool leerEnteroDescriptor(int fd, uint64_t& valor) {
+
+    char buffer[32];
+    ssize_t leidos = pread(fd, buffer, sizeof(buffer), 0);
+    if (leidos <= 0) return false;
+    const char* p = buffer;
+    valor = leerEnteroTexto(p, buffer + leidos);
+    return p != buffer;
+
+}
+
+/**
+ * @brief Muestreador de baja sobrecarga que llena un objeto Procesamiento con datos de la maquina.
+ * 
+ * Abre una sola vez /proc/stat, los scaling_cur_freq de cpufreq y los contadores RAPL de powercap,
+ * y en cada tick los relee con pread sobre descriptores abiertos, sin asignar memoria. La carga y la
+ * potencia se calculan como diferencias entre dos ticks; las fuentes ausentes (maquinas virtuales,
+ * RAPL sin permisos de lectura) se omiten y el campo correspondiente conserva su valor anterior.
+ */
+class MuestreadorCPU {
+
+    private:
+    int fdStat;
+    std::vector<int> fdsFrecuencia;
+    std::vector<int> fdsEnergia;
+    std::vector<uint64_t> rangoEnergia;
+    std::vector<uint64_t> energiaAnterior;
+    uint64_t ocupadoAnterior;
+    uint64_t totalAnterior;
+    std::chrono::steady_clock::time_point tiempoAnterior;
+    int cores;
+    bool primerTick;
+
+    /**
+     * @brief Lee la linea agregada "cpu" de /proc/stat.
+     * 
+     * @param ocupado Jiffies fuera de idle e iowait.
+     * @param total Jiffies totales.
+     * @return bool 
+     */
+    bool leerStat(uint64_t& ocupado, uint64_t& total) const {
+
+        // La primera linea cabe de sobra en 256 bytes incluso con contadores de 20 digitos.
+        char buffer[256];
+        ssize_t leidos = pread(fdStat, buffer, sizeof(buffer), 0);
+        if (leidos < 4 || std::strncmp(buffer, "cpu ", 4) != 0) return false;
+        const char* p = buffer + 4;
+        const char* fin = buffer + leidos;
+        uint64_t campos[8];
+        for (int i = 0; i < 8; i++) campos[i] = leerEnteroTexto(p, fin);
+        // user nice system idle iowait irq softirq steal; guest ya esta incluido en user.
+        total = 0;
+        for (int i = 0; i < 8; i++) total += campos[i];
+        ocupado = total - campos[3] - campos[4];
+        return true;
+
+    }
+
+    public:
+    /**
+     * @brief Constructor que abre todas las fuentes disponibles.
+     * 
+     */
+    MuestreadorCPU() : ocupadoAnterior(0), totalAnterior(0), primerTick(true) {
+
+        fdStat = open("/proc/stat", O_RDONLY | O_CLOEXEC);
+        long enLinea = sysconf(_SC_NPROCESSORS_ONLN);
+        cores = enLinea > 0 ? static_cast<int>(enLinea) : 1;
+
+        char ruta[96];
+        for (int i = 0; i < cores; i++) {
+            std::snprintf(ruta, sizeof(ruta), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_cur_freq", i);
+            int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+            if (fd >= 0) fdsFrecuencia.push_back(fd);
+        }
+
+        // Un dominio "package" por socket: intel-rapl:0, intel-rapl:1, ...
+        for (int i = 0; ; i++) {
+            std::snprintf(ruta, sizeof(ruta), "/sys/class/powercap/intel-rapl:%d/energy_uj", i);
+            int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) break;
+            uint64_t actual = 0;
+            if (!leerEnteroDescriptor(fd, actual)) {
+                close(fd);
+                break;
+            }
+            uint64_t rango = 0;
+            std::snprintf(ruta, sizeof(ruta), "/sys/class/powercap/intel-rapl:%d/max_energy_range_uj", i);
+            int fdRango = open(ruta, O_RDONLY | O_CLOEXEC);
+            if (fdRango >= 0) {
+                leerEnteroDescriptor(fdRango, rango);
+                close(fdRango);
+            }
+            fdsEnergia.push_back(fd);
+            rangoEnergia.push_back(rango);
+            energiaAnterior.push_back(actual);
+        }
+
+    }
+
+    MuestreadorCPU(const MuestreadorCPU&) = delete;
+    MuestreadorCPU& operator=(const MuestreadorCPU&) = delete;
+
+    /**
+     * @brief Destructor que cierra los descriptores.
+     * 
+     */
+    ~MuestreadorCPU() {
+
+        if (fdStat >= 0) close(fdStat);
+        for (int fd : fdsFrecuencia) close(fd);
+        for (int fd : fdsEnergia) close(fd);
+
+    }
+
+    bool tieneCarga() const { return fdStat >= 0; }
+    bool tieneFrecuencia() const { return !fdsFrecuencia.empty(); }
+    bool tieneEnergia() const { return !fdsEnergia.empty(); }
+
+    /**
+     * @brief Toma una muestra y la escribe en el componente.
+     * 
+     * En el primer tick la carga es el promedio desde el arranque y la energia no se modifica,
+     * porque la potencia requiere dos lecturas.
+     * 
+     * @param componente 
+     * @return bool true si la muestra ya corresponde a un intervalo entre dos ticks.
+     */
+    bool muestrear(Procesamiento& componente) {
+
+        auto ahora = std::chrono::steady_clock::now();
+        double segundos = std::chrono::duration<double>(ahora - tiempoAnterior).count();
+
+        uint64_t ocupado, total;
+        if (fdStat >= 0 && leerStat(ocupado, total)) {
+            uint64_t deltaTotal = total - totalAnterior;
+            if (deltaTotal > 0) {
+                componente.setCargaProcesamiento(100.0f * static_cast<float>(ocupado - ocupadoAnterior) / static_cast<float>(deltaTotal));
+            }
+            ocupadoAnterior = ocupado;
+            totalAnterior   = total;
+        }
+
+        if (!fdsFrecuencia.empty()) {
+            uint64_t sumaKHz = 0;
+            int leidas = 0;
+            for (int fd : fdsFrecuencia) {
+                uint64_t kHz;
+                if (leerEnteroDescriptor(fd, kHz)) {
+                    sumaKHz += kHz;
+                    leidas++;
+                }
+            }
+            if (leidas > 0) componente.actualizarFrecuencia(static_cast<float>(sumaKHz) / leidas / 1e6f, cores);
+        } else {
+            componente.actualizarFrecuencia(componente.getFrecuencia(), cores);
+        }
+
+        if (!fdsEnergia.empty()) {
+            uint64_t microJoules = 0;
+            for (size_t i = 0; i < fdsEnergia.size(); i++) {
+                uint64_t actual;
+                if (!leerEnteroDescriptor(fdsEnergia[i], actual)) continue;
+                // El contador da la vuelta al llegar a max_energy_range_uj. Sin ese rango no se puede
+                // reconstruir el delta de la vuelta y la muestra de ese dominio se descarta.
+                if (actual >= energiaAnterior[i]) microJoules += actual - energiaAnterior[i];
+                else if (rangoEnergia[i] > 0) microJoules += actual + rangoEnergia[i] - energiaAnterior[i];
+                energiaAnterior[i] = actual;
+            }
+            if (!primerTick && segundos > 0) componente.setEnergiaConsumida(static_cast<float>(microJoules / 1e6 / segundos));
+        }
+
+        bool intervalo = !primerTick;
+        tiempoAnterior = ahora;
+        primerTick = false;
+        return intervalo;
+
+    }
+
+};
+
+/**
+ * @brief Muestrea la CPU de la maquina durante varios ticks y mide el costo de cada muestra.
+ * 
+ * @param ticks 
+ * @param intervaloMs 
+ */
+void monitorearCPU(int ticks, int intervaloMs) {
+
+    CPU cpu(0, 0, 0, 0, 0, 0);
+    MuestreadorCPU muestreador;
+    std::cout << "Fuentes: carga " << (muestreador.tieneCarga() ? "si" : "no")
+              << ", frecuencia " << (muestreador.tieneFrecuencia() ? "si" : "no")
+              << ", energia " << (muestreador.tieneEnergia() ? "si" : "no") << "\n";
+    muestreador.muestrear(cpu);
+
+    double costoTotalNs = 0;
+    for (int i = 0; i < ticks; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervaloMs));
+        auto inicio = std::chrono::steady_clock::now();
+        muestreador.muestrear(cpu);
+        auto fin = std::chrono::steady_clock::now();
+        costoTotalNs += std::chrono::duration<double, std::nano>(fin - inicio).count();
+        cpu.estadoProcesamiento();
+    }
+    if (ticks > 0) std::cout << "Costo promedio por tick: " << costoTotalNs / ticks / 1000.0 << " us\n";
+
+}
+
+/*******************************************
+ * Telemetria en vivo de discos            *
+ *******************************************/
+
+/**
+ * @brief Muestreador de /proc/diskstats que publica rendimiento, IOPS, utilizacion y latencia en componentes de almacenamiento.
+ * 
+ * El archivo se abre una vez y en cada tick se relee completo con pread, hasta el fin del archivo, en un
+ * buffer reservado en el constructor que solo crece si no alcanza. El parseo recorre el buffer una sola vez, linea por linea, sin iostreams ni asignaciones,
+ * y solo convierte los contadores de los dispositivos vinculados. Las metricas se calculan como
+ * diferencias entre dos ticks:
+ *   - velocidadAcceso: MB/s leidos y escritos (sectores de 512 bytes).
+ *   - iops: lecturas y escrituras completadas por segundo.
+ *   - cargaProcesamiento: porcentaje del intervalo con E/S en curso (campo io_ticks).
+ *   - latenciaPromedio: ms de lectura y escritura acumulados divididos por las operaciones completadas.
+ */
+class MuestreadorDisco {
+
+    private:
+    /**
+     * @brief Contadores acumulados de /proc/diskstats que interesan.
+     * 
+     */
+    struct ContadoresDisco {
+        uint64_t lecturas;
+        uint64_t sectoresLeidos;
+        uint64_t msLectura;
+        uint64_t escrituras;
+        uint64_t sectoresEscritos;
+        uint64_t msEscritura;
+        uint64_t msOcupado;
+    };
+
+    /**
+     * @brief Vinculo entre un nombre de dispositivo y los componentes que reciben sus metricas.
+     * 
+     */
+    struct EnlaceDisco {
+        char nombre[32];
+        size_t largoNombre;
+        Almacenamiento* destinos[2];
+        int cantidadDestinos;
+        ContadoresDisco anterior;
+        bool tieneAnterior;
+    };
+
+    int fd;
+    std::vector<char> buffer;
+    std::vector<EnlaceDisco> enlaces;
+    std::chrono::steady_clock::time_point tiempoAnterior;
+    bool primerTick;
+
+    /**
+     * @brief Registra un destino para un dispositivo, creando el vinculo si no existe.
+     * 
+     * @param dispositivo 
+     * @param destino 
+     */
+    void agregarDestino(const char* dispositivo, Almacenamiento* destino) {
+
+        size_t largo = std::strlen(dispositivo);
+        if (largo == 0 || largo >= sizeof(EnlaceDisco::nombre)) return;
+        for (EnlaceDisco& enlace : enlaces) {
+            if (enlace.largoNombre == largo && std::memcmp(enlace.nombre, dispositivo, largo) == 0) {
+                if (enlace.cantidadDestinos < 2) enlace.destinos[enlace.cantidadDestinos++] = destino;
+                return;
+            }
+        }
+        EnlaceDisco enlace{};
+        std::memcpy(enlace.nombre, dispositivo, largo);
+        enlace.largoNombre = largo;
+        enlace.destinos[0] = destino;
+        enlace.cantidadDestinos = 1;
+        enlaces.push_back(enlace);
+
+    }
+
+    /**
+     * @brief Publica en los destinos las diferencias entre dos lecturas.
+     * 
+     * @param enlace 
+     * @param actual 
+     * @param segundos 
+     */
+    static void publicar(const EnlaceDisco& enlace, const ContadoresDisco& actual, double segundos) {
+
+        const ContadoresDisco& previo = enlace.anterior;
+        uint64_t operaciones = (actual.lecturas - previo.lecturas) + (actual.escrituras - previo.escrituras);
+        uint64_t sectores    = (actual.sectoresLeidos - previo.sectoresLeidos) + (actual.sectoresEscritos - previo.sectoresEscritos);
+        uint64_t msEspera    = (actual.msLectura - previo.msLectura) + (actual.msEscritura - previo.msEscritura);
+        float velocidad   = static_cast<float>(sectores * 512.0 / 1e6 / segundos);
+        float iops        = static_cast<float>(operaciones / segundos);
+        float latencia    = operaciones > 0 ? static_cast<float>(msEspera) / operaciones : 0.0f;
+        float utilizacion = static_cast<float>((actual.msOcupado - previo.msOcupado) / (segundos * 10.0));
+        if (utilizacion > 100.0f) utilizacion = 100.0f;
+        for (int i = 0; i < enlace.cantidadDestinos; i++) {
+            enlace.destinos[i]->actualizarES(velocidad, iops, latencia);
+            enlace.destinos[i]->setCargaProcesamiento(utilizacion);
+        }
+
+    }
+
+    public:
+    /**
+     * @brief Constructor que abre /proc/diskstats y reserva el buffer de lectura.
+     * 
+     */
+    MuestreadorDisco() : buffer(64 * 1024), primerTick(true) {
+
+        fd = open("/proc/diskstats", O_RDONLY | O_CLOEXEC);
+
+    }
+
+    MuestreadorDisco(const MuestreadorDisco&) = delete;
+    MuestreadorDisco& operator=(const MuestreadorDisco&) = delete;
+
+    /**
+     * @brief Destructor que cierra el descriptor.
+     * 
+     */
+    ~MuestreadorDisco() {
+
+        if (fd >= 0) close(fd);
+
+    }
+
+    bool disponible() const { return fd >= 0; }
+
+    /**
+     * @brief Vincula un dispositivo (por ejemplo "sda" o "nvme0n1") con un componente de almacenamiento.
+     * 
+     * @param dispositivo Nombre tal como aparece en /proc/diskstats.
+     * @param destino 
+     */
+    void vincular(const char* dispositivo, Almacenamiento& destino) {
+
+        agregarDestino(dispositivo, &destino);
+
+    }
+
+    /**
+     * @brief Relee /proc/diskstats y actualiza los componentes vinculados.
+     * 
+     * En el primer tick solo se guardan los contadores; las metricas se publican desde el segundo.
+     * 
+     * @return int Cantidad de dispositivos vinculados encontrados en el archivo.
+     */
+    int muestrear() {
+
+        if (fd < 0) return 0;
+        auto ahora = std::chrono::steady_clock::now();
+        double segundos = std::chrono::duration<double>(ahora - tiempoAnterior).count();
+
+        // Se lee hasta el fin del archivo; el buffer solo crece si la maquina tiene mas dispositivos de los que caben.
+        size_t leidos = 0;
+        for (;;) {
+            if (leidos == buffer.size()) buffer.resize(2 * buffer.size());
+            ssize_t n = pread(fd, buffer.data() + leidos, buffer.size() - leidos, static_cast<off_t>(leidos));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return 0;
+            }
+            if (n == 0) break;
+            leidos += static_cast<size_t>(n);
+        }
+        if (leidos == 0) return 0;
+
+        int encontrados = 0;
+        const char* p   = buffer.data();
+        const char* fin = p + leidos;
+        while (p < fin) {
+            // Solo se interpretan lineas completas.
+            const char* finLinea = static_cast<const char*>(std::memchr(p, '\n', fin - p));
+            if (finLinea == nullptr) break;
+
+            // major minor nombre ...
+            leerEnteroTexto(p, finLinea);
+            leerEnteroTexto(p, finLinea);
+            while (p < finLinea && *p == ' ') ++p;
+            const char* nombre = p;
+            while (p < finLinea && *p != ' ') ++p;
+            size_t largo = p - nombre;
+
+            for (EnlaceDisco& enlace : enlaces) {
+                if (enlace.largoNombre != largo || std::memcmp(enlace.nombre, nombre, largo) != 0) continue;
+                uint64_t campos[10];
+                for (int i = 0; i < 10; i++) campos[i] = leerEnteroTexto(p, finLinea);
+                // lecturas, fusionadas, sectores, ms, escrituras, fusionadas, sectores, ms, en curso, io_ticks
+                ContadoresDisco actual{campos[0], campos[2], campos[3], campos[4], campos[6], campos[7], campos[9]};
+                if (enlace.tieneAnterior && !primerTick && segundos > 0) publicar(enlace, actual, segundos);
+                enlace.anterior = actual;
+                enlace.tieneAnterior = true;
+                encontrados++;
+                break;
+            }
+            p = finLinea + 1;
+        }
+
+        tiempoAnterior = ahora;
+        primerTick = false;
+        return encontrados;
+
+    }
+
+};
+
+/**
+ * @brief Muestrea un disco de la maquina durante varios ticks y mide el costo de cada muestra.
+ * 
+ * @param dispositivo 
+ * @param ticks 
+ * @param intervaloMs 
+ */
+void monitorearDisco(const char* dispositivo, int ticks, int intervaloMs) {
+
+    SSD disco(0, 0, 0, 0, "?", "?");
+    MuestreadorDisco muestreador;
+    muestreador.vincular(dispositivo, disco);
+    if (muestreador.muestrear() == 0) {
+        std::cout << "Dispositivo no encontrado en /proc/diskstats: " << dispositivo << "\n";
+        return;
+    }
+
+    double costoTotalNs = 0;
+    for (int i = 0; i < ticks; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervaloMs));
+        auto inicio = std::chrono::steady_clock::now();
+        muestreador.muestrear();
+        auto fin = std::chrono::steady_clock::now();
+        costoTotalNs += std::chrono::duration<double, std::nano>(fin - inicio).count();
+        std::cout << dispositivo << ": " << disco.getVelocidadAcceso() << " MB/s, " << disco.getIops() << " IOPS, "
+                  << disco.getCargaProcesamiento() << "% ocupado, " << disco.getLatenciaPromedio() << " ms/op\n";
+    }
+    if (ticks > 0) std::cout << "Costo promedio por tick: " << costoTotalNs / ticks / 1000.0 << " us\n";
+
+}
+
+/*********************************************
+ * Registro de componentes orientado a datos *
+ *********************************************/
+
+/**
+ * @brief Tipos concretos de componente que guarda el registro.
+ * 
+ */
+enum TipoComponente {
+    TIPO_CPU,
+    TIPO_GPU,
+    TIPO_HDD,
+    TIPO_SSD,
+    TIPO_SSHD,
+    TIPO_COMPONENTE_TOTAL
+};
+
+/**
+ * @brief Nombre corto de un tipo de componente.
+ * 
+ * @param tipo 
+ * @return const char* 
+ */
+inline const char* nombreTipo(TipoComponente tipo) {
+
+    static const char* const NOMBRES[TIPO_COMPONENTE_TOTAL] = {"cpu", "gpu", "hdd", "ssd", "sshd"};
+    return tipo < TIPO_COMPONENTE_TOTAL ? NOMBRES[tipo] : "?";
+
+}
+
+/**
+ * @brief Referencia liviana a un componente del registro: su tipo y su posicion en el pool de ese tipo.
+ * 
+ */
+struct ManejadorComponente {
+    TipoComponente tipo;
+    uint32_t indice;
+};
+
+/**
+ * @brief Columnas comunes a todos los componentes, una entrada por componente.
+ * 
+ */
+struct ColumnasComponente {
+    std::vector<float> energiaConsumida;
+    std::vector<float> cargaProcesamiento;
+
+    size_t cantidad() const { return energiaConsumida.size(); }
+
+    void agregarComponente(const Componente& componente) {
+        energiaConsumida.push_back(componente.getEnergiaConsumida());
+        cargaProcesamiento.push_back(componente.getCargaProcesamiento());
+    }
+};
+
+/**
+ * @brief Columnas de los componentes de procesamiento.
+ * 
+ */
+struct ColumnasProcesamiento : ColumnasComponente {
+    std::vector<float> frecuencia;
+    std::vector<int> cores;
+
+    void agregarProcesamiento(const Procesamiento& componente) {
+        agregarComponente(componente);
+        frecuencia.push_back(componente.getFrecuencia());
+        cores.push_back(componente.getCores());
+    }
+};
+
+/**
+ * @brief Columnas de los componentes de almacenamiento. La interfaz es un dato frio y se guarda aparte.
+ * 
+ */
+struct ColumnasAlmacenamiento : ColumnasComponente {
+    std::vector<float> capacidadAlmacenamiento;
+    std::vector<float> velocidadAcceso;
+    std::vector<float> iops;
+    std::vector<float> latenciaPromedio;
+    std::vector<std::string> tipoInterfaz;
+
+    void agregarAlmacenamiento(const Almacenamiento& componente) {
+        agregarComponente(componente);
+        capacidadAlmacenamiento.push_back(componente.getCapacidadAlmacenamiento());
+        velocidadAcceso.push_back(componente.getVelocidadAcceso());
+        iops.push_back(componente.getIops());
+        latenciaPromedio.push_back(componente.getLatenciaPromedio());
+        tipoInterfaz.push_back(componente.getTipoInterfaz());
+    }
+};
+
+struct PoolCPU : ColumnasProcesamiento {
+    std::vector<int> numeroProcesador;
+    std::vector<int> cacheL3;
+};
+
+struct PoolGPU : ColumnasProcesamiento {
+    std::vector<float> memoria;
+};
+
+struct PoolHDD : ColumnasAlmacenamiento {
+    std::vector<int> rpm;
+    std::vector<int> memoriaCache;
+};
+
+struct PoolSSD : ColumnasAlmacenamiento {
+    std::vector<std::string> tipoMemoria;
+};
+
+struct PoolSSHD : ColumnasAlmacenamiento {
+    std::vector<int> rpm;
+    std::vector<int> memoriaCache;
+    std::vector<std::string> tipoMemoria;
+    std::vector<float> velocidadDisco;
+    std::vector<float> velocidadCache;
+    std::vector<float> capacidadCache;
+    std::vector<float> tasaAciertos;
+};
+
+/**
+ * @brief Resumen de las metricas de un tipo de componente en un tick.
+ * 
+ */
+struct ResumenTipo {
+    size_t cantidad;
+    double energiaTotal;
+    double cargaPromedio;
+    float cargaMaxima;
+};
+
+/**
+ * @brief Registro que guarda cada tipo concreto de componente en su propio pool contiguo, en forma de columnas.
+ * 
+ * Las clases de la jerarquia siguen siendo la forma de construir y mostrar un componente individual, pero el
+ * estado de la flota vive aqui: agregar() copia un objeto a las columnas de su tipo y devuelve un manejador,
+ * y materializar un CPU, GPU, HDD, SSD o SSHD desde un manejador permite seguir usando mostrarEstado().
+ * Las actualizaciones por tick y los reportes recorren cada pool con un ciclo simple, sin punteros ni
+ * llamadas virtuales, de modo que el compilador puede vectorizarlos.
+ */
+class RegistroComponentes {
+
+    public:
+    PoolCPU cpus;
+    PoolGPU gpus;
+    PoolHDD hdds;
+    PoolSSD ssds;
+    PoolSSHD sshds;
+
+    ManejadorComponente agregar(const CPU& componente) {
+        cpus.agregarProcesamiento(componente);
+        cpus.numeroProcesador.push_back(componente.getNumeroProcesador());
+        cpus.cacheL3.push_back(componente.getCacheL3());
+        return {TIPO_CPU, static_cast<uint32_t>(cpus.cantidad() - 1)};
+    }
+
+    ManejadorComponente agregar(const GPU& componente) {
+        gpus.agregarProcesamiento(componente);
+        gpus.memoria.push_back(componente.getMemoria());
+        return {TIPO_GPU, static_cast<uint32_t>(gpus.cantidad() - 1)};
+    }
+
+    ManejadorComponente agregar(const HDD& componente) {
+        hdds.agregarAlmacenamiento(componente);
+        hdds.rpm.push_back(componente.getRpm());
+        hdds.memoriaCache.push_back(componente.getMemoriaCache());
+        return {TIPO_HDD, static_cast<uint32_t>(hdds.cantidad() - 1)};
+    }
+
+    ManejadorComponente agregar(const SSD& componente) {
+        ssds.agregarAlmacenamiento(componente);
+        ssds.tipoMemoria.push_back(componente.getTipoMemoria());
+        return {TIPO_SSD, static_cast<uint32_t>(ssds.cantidad() - 1)};
+    }
+
+    ManejadorComponente agregar(const SSHD& componente) {
+        sshds.agregarAlmacenamiento(componente);
+        sshds.rpm.push_back(componente.getRpm());
+        sshds.memoriaCache.push_back(componente.getMemoriaCache());
+        sshds.tipoMemoria.push_back(componente.getTipoMemoria());
+        sshds.velocidadDisco.push_back(componente.getVelocidadDisco());
+        sshds.velocidadCache.push_back(componente.getVelocidadCache());
+        sshds.capacidadCache.push_back(componente.getCapacidadCache());
+        sshds.tasaAciertos.push_back(componente.getTasaAciertos());
+        return {TIPO_SSHD, static_cast<uint32_t>(sshds.cantidad() - 1)};
+    }
+
+    /**
+     * @brief Columnas comunes del pool de un tipo.
+     * 
+     * @param tipo 
+     * @return ColumnasComponente& 
+     */
+    ColumnasComponente& columnas(TipoComponente tipo) {
+
+        switch (tipo) {
+            case TIPO_CPU: return cpus;
+            case TIPO_GPU: return gpus;
+            case TIPO_HDD: return hdds;
+            case TIPO_SSD: return ssds;
+            case TIPO_SSHD: return sshds;
+            default: throw std::invalid_argument("Tipo de componente desconocido");
+        }
+
+    }
+
+    const ColumnasComponente& columnas(TipoComponente tipo) const {
+
+        return const_cast<RegistroComponentes*>(this)->columnas(tipo);
+
+    }
+
+    size_t cantidad(TipoComponente tipo) const { return columnas(tipo).cantidad(); }
+
+    /**
+     * @brief Verifica que un manejador apunte a un componente existente del registro.
+     * 
+     * @param m 
+     * @throw std::out_of_range si el indice esta fuera del pool de su tipo.
+     */
+    void validar(ManejadorComponente m) const {
+
+        if (m.indice >= columnas(m.tipo).cantidad()) throw std::out_of_range("Indice de componente fuera de rango");
+
+    }
+
+    size_t cantidadTotal() const {
+
+        return cpus.cantidad() + gpus.cantidad() + hdds.cantidad() + ssds.cantidad() + sshds.cantidad();
+
+    }
+
+    float getCargaProcesamiento(ManejadorComponente m) const { validar(m); return columnas(m.tipo).cargaProcesamiento[m.indice]; }
+    float getEnergiaConsumida(ManejadorComponente m) const { validar(m); return columnas(m.tipo).energiaConsumida[m.indice]; }
+
+    /**
+     * @brief Escribe en el registro el consumo y la carga de un componente.
+     * 
+     * @param m 
+     * @param _energiaConsumida 
+     * @param _cargaProcesamiento 
+     */
+    void actualizarConsumo(ManejadorComponente m, float _energiaConsumida, float _cargaProcesamiento) {
+
+        validar(m);
+        ColumnasComponente& c = columnas(m.tipo);
+        c.energiaConsumida[m.indice]   = _energiaConsumida;
+        c.cargaProcesamiento[m.indice] = _cargaProcesamiento;
+
+    }
+
+    /**
+     * @brief Copia al registro una muestra tomada sobre un objeto Procesamiento (por ejemplo con MuestreadorCPU).
+     * 
+     * @param m Manejador de una CPU o GPU.
+     * @param componente 
+     * @throw std::invalid_argument si el manejador no es de CPU ni GPU.
+     * @throw std::out_of_range si el indice no existe.
+     */
+    void actualizarDesde(ManejadorComponente m, const Procesamiento& componente) {
+
+        if (m.tipo != TIPO_CPU && m.tipo != TIPO_GPU) throw std::invalid_argument("El manejador no es de un componente de procesamiento");
+        validar(m);
+        ColumnasProcesamiento& c = m.tipo == TIPO_CPU ? static_cast<ColumnasProcesamiento&>(cpus) : gpus;
+        c.energiaConsumida[m.indice]   = componente.getEnergiaConsumida();
+        c.cargaProcesamiento[m.indice] = componente.getCargaProcesamiento();
+        c.frecuencia[m.indice]         = componente.getFrecuencia();
+        c.cores[m.indice]              = componente.getCores();
+
+    }
+
+    /**
+     * @brief Copia al registro una muestra tomada sobre un objeto Almacenamiento (por ejemplo con MuestreadorDisco).
+     * 
+     * @param m Manejador de un HDD, SSD o SSHD.
+     * @param componente 
+     * @throw std::invalid_argument si el manejador no es de almacenamiento.
+     * @throw std::out_of_range si el indice no existe.
+     */
+    void actualizarDesde(ManejadorComponente m, const Almacenamiento& componente) {
+
+        if (m.tipo != TIPO_HDD && m.tipo != TIPO_SSD && m.tipo != TIPO_SSHD) throw std::invalid_argument("El manejador no es de un componente de almacenamiento");
+        validar(m);
+        ColumnasAlmacenamiento& c = m.tipo == TIPO_HDD ? static_cast<ColumnasAlmacenamiento&>(hdds)
+                                  : m.tipo == TIPO_SSD ? static_cast<ColumnasAlmacenamiento&>(ssds) : sshds;
+        c.energiaConsumida[m.indice]   = componente.getEnergiaConsumida();
+        c.cargaProcesamiento[m.indice] = componente.getCargaProcesamiento();
+        c.velocidadAcceso[m.indice]    = componente.getVelocidadAcceso();
+        c.iops[m.indice]               = componente.getIops();
+        c.latenciaPromedio[m.indice]   = componente.getLatenciaPromedio();
+
+    }
+
+    /**
+     * @brief Aplica una funcion a la energia y la carga de todos los componentes de un tipo.
+     * 
+     * La funcion recibe (indice, energia&, carga&) y se expande en linea dentro del ciclo.
+     * 
+     * @param tipo 
+     * @param funcion 
+     */
+    template <class Funcion>
+    void actualizarTick(TipoComponente tipo, Funcion funcion) {
+
+        ColumnasComponente& c = columnas(tipo);
+        float* energia = c.energiaConsumida.data();
+        float* carga   = c.cargaProcesamiento.data();
+        size_t n = c.cantidad();
+        for (size_t i = 0; i < n; i++) funcion(i, energia[i], carga[i]);
+
+    }
+
+    /**
+     * @brief Resume la energia total y la carga promedio y maxima de un tipo.
+     * 
+     * @param tipo 
+     * @return ResumenTipo 
+     */
+    ResumenTipo resumen(TipoComponente tipo) const {
+
+        const ColumnasComponente& c = columnas(tipo);
+        const float* energia = c.energiaConsumida.data();
+        const float* carga   = c.cargaProcesamiento.data();
+        size_t n = c.cantidad();
+        double energiaTotal = 0, cargaTotal = 0;
+        float cargaMaxima = 0;
+        for (size_t i = 0; i < n; i++) {
+            energiaTotal += energia[i];
+            cargaTotal   += carga[i];
+            cargaMaxima   = carga[i] > cargaMaxima ? carga[i] : cargaMaxima;
+        }
+        return {n, energiaTotal, n > 0 ? cargaTotal / n : 0.0, cargaMaxima};
+
+    }
+
+    /**
+     * @brief Agrega al texto un reporte por tipo, sin vaciar el flujo por cada linea.
+     * 
+     * @param salida 
+     */
+    void reportar(std::string& salida) const {
+
+        char linea[160];
+        for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+            ResumenTipo r = resumen(static_cast<TipoComponente>(t));
+            if (r.cantidad == 0) continue;
+            int largo = std::snprintf(linea, sizeof(linea), "%-4s cantidad: %zu, Energia Total: %.1f Watt, Carga Promedio: %.1f%%, Carga Maxima: %.1f%%\n",
+                                      nombreTipo(static_cast<TipoComponente>(t)), r.cantidad, r.energiaTotal, r.cargaPromedio, r.cargaMaxima);
+            salida.append(linea, largo);
+        }
+
+    }
+
+    CPU cpu(uint32_t i) const {
+
+        return CPU(cpus.energiaConsumida[i], cpus.cargaProcesamiento[i], cpus.frecuencia[i], cpus.cores[i], cpus.numeroProcesador[i], cpus.cacheL3[i]);
+
+    }
+
+    GPU gpu(uint32_t i) const {
+
+        return GPU(gpus.energiaConsumida[i], gpus.cargaProcesamiento[i], gpus.frecuencia[i], gpus.cores[i], gpus.memoria[i]);
+
+    }
+
+    HDD hdd(uint32_t i) const {
+
+        HDD disco(hdds.energiaConsumida[i], hdds.cargaProcesamiento[i], hdds.capacidadAlmacenamiento[i], hdds.velocidadAcceso[i], hdds.tipoInterfaz[i], hdds.rpm[i], hdds.memoriaCache[i]);
+        disco.actualizarES(hdds.velocidadAcceso[i], hdds.iops[i], hdds.latenciaPromedio[i]);
+        return disco;
+
+    }
+
+    SSD ssd(uint32_t i) const {
+
+        SSD disco(ssds.energiaConsumida[i], ssds.cargaProcesamiento[i], ssds.capacidadAlmacenamiento[i], ssds.velocidadAcceso[i], ssds.tipoInterfaz[i], ssds.tipoMemoria[i]);
+        disco.actualizarES(ssds.velocidadAcceso[i], ssds.iops[i], ssds.latenciaPromedio[i]);
+        return disco;
+
+    }
+
+    SSHD sshd(uint32_t i) const {
+
+        SSHD disco(sshds.energiaConsumida[i], sshds.cargaProcesamiento[i], sshds.capacidadAlmacenamiento[i], sshds.velocidadDisco[i], sshds.tipoInterfaz[i], sshds.rpm[i], sshds.memoriaCache[i], sshds.tipoMemoria[i], sshds.velocidadCache[i], sshds.capacidadCache[i]);
+        disco.setTasaAciertos(sshds.tasaAciertos[i]);
+        disco.actualizarES(sshds.velocidadAcceso[i], sshds.iops[i], sshds.latenciaPromedio[i]);
+        return disco;
+
+    }
+
+    /**
+     * @brief Muestra el estado de un componente con el formato de su clase.
+     * 
+     * @param m 
+     */
+    void mostrarEstado(ManejadorComponente m) const {
+
+        validar(m);
+        switch (m.tipo) {
+            case TIPO_CPU:  { CPU c = cpu(m.indice);   c.estadoProcesamiento();  c.mostrarEstado(); break; }
+            case TIPO_GPU:  { GPU c = gpu(m.indice);   c.estadoProcesamiento();  c.mostrarEstado(); break; }
+            case TIPO_HDD:  { HDD c = hdd(m.indice);   c.estadoAlmacenamiento(); c.mostrarEstado(); break; }
+            case TIPO_SSD:  { SSD c = ssd(m.indice);   c.estadoAlmacenamiento(); c.mostrarEstado(); break; }
+            case TIPO_SSHD: { SSHD c = sshd(m.indice); c.estadoAlmacenamiento(); c.mostrarEstado(); break; }
+            default:        break;
+        }
+
+    }
+
+};
+
+/**
+ * @brief Llena un registro con una flota sintetica de n nodos, cada uno con un componente de cada tipo.
+ * 
+ * @param registro 
+ * @param nodos 
+ */
+void generarFlota(RegistroComponentes& registro, size_t nodos) {
+
+    uint32_t estado = 2463534242u;
+    auto azar = [&estado](float minimo, float maximo) {
+        estado ^= estado << 13; estado ^= estado >> 17; estado ^= estado << 5;
+        return minimo + (maximo - minimo) * static_cast<float>(estado >> 8) / 16777216.0f;
+    };
+    for (size_t i = 0; i < nodos; i++) {
+        registro.agregar(CPU(azar(40, 180), azar(0, 100), azar(2.0f, 4.5f), 16, static_cast<int>(i), 32));
+        registro.agregar(GPU(azar(80, 350), azar(0, 100), azar(1.2f, 2.2f), 8192, azar(400, 1000)));
+        registro.agregar(HDD(azar(6, 10), azar(0, 100), 8000, azar(80, 250), "SATA", 7200, 256));
+        registro.agregar(SSD(azar(2, 8), azar(0, 100), 2000, azar(500, 7000), "NVMe", "TLC"));
+        registro.agregar(SSHD(azar(6, 10), azar(0, 100), 2000, azar(100, 300), "SATA", 5400, 64, "MLC"));
+    }
+
+}
+
+/**
+ * @brief Compara un tick de actualizacion y resumen sobre objetos dispersos en el heap contra el registro por columnas.
+ * 
+ * @param nodos 
+ */
+void compararRegistro(size_t nodos) {
+
+    RegistroComponentes registro;
+    generarFlota(registro, nodos);
+
+    // Flota equivalente como objetos individuales, en orden aleatorio como quedaria tras altas y bajas.
+    std::vector<std::unique_ptr<Componente>> objetos;
+    for (uint32_t i = 0; i < registro.cpus.cantidad(); i++)  objetos.emplace_back(new CPU(registro.cpu(i)));
+    for (uint32_t i = 0; i < registro.gpus.cantidad(); i++)  objetos.emplace_back(new GPU(registro.gpu(i)));
+    for (uint32_t i = 0; i < registro.hdds.cantidad(); i++)  objetos.emplace_back(new HDD(registro.hdd(i)));
+    for (uint32_t i = 0; i < registro.ssds.cantidad(); i++)  objetos.emplace_back(new SSD(registro.ssd(i)));
+    for (uint32_t i = 0; i < registro.sshds.cantidad(); i++) objetos.emplace_back(new SSHD(registro.sshd(i)));
+    std::mt19937 generador(7);
+    std::shuffle(objetos.begin(), objetos.end(), generador);
+
+    const int TICKS = 20;
+    auto tickCarga = [](float carga) { return carga < 99.0f ? carga + 0.5f : 0.0f; };
+
+    auto inicio = std::chrono::steady_clock::now();
+    double controlObjetos = 0;
+    for (int t = 0; t < TICKS; t++) {
+        double energia = 0;
+        for (auto& objeto : objetos) {
+            objeto->setCargaProcesamiento(tickCarga(objeto->getCargaProcesamiento()));
+            energia += objeto->getEnergiaConsumida();
+        }
+        controlObjetos += energia;
+    }
+    auto medio = std::chrono::steady_clock::now();
+    double controlRegistro = 0;
+    for (int t = 0; t < TICKS; t++) {
+        double energia = 0;
+        for (int tipo = 0; tipo < TIPO_COMPONENTE_TOTAL; tipo++) {
+            registro.actualizarTick(static_cast<TipoComponente>(tipo), [&](size_t, float&, float& carga) { carga = tickCarga(carga); });
+            energia += registro.resumen(static_cast<TipoComponente>(tipo)).energiaTotal;
+        }
+        controlRegistro += energia;
+    }
+    auto fin = std::chrono::steady_clock::now();
+
+    double total = static_cast<double>(objetos.size()) * TICKS;
+    double nsObjetos  = std::chrono::duration<double, std::nano>(medio - inicio).count() / total;
+    double nsRegistro = std::chrono::duration<double, std::nano>(fin - medio).count() / total;
+    std::cout << "Componentes: " << objetos.size() << ", ticks: " << TICKS << "\n";
+    std::cout << "Objetos en heap:   " << nsObjetos << " ns/componente (control " << controlObjetos << ")\n";
+    std::cout << "Registro columnas: " << nsRegistro << " ns/componente (control " << controlRegistro << ")\n";
+    std::string reporte;
+    registro.reportar(reporte);
+    std::cout << reporte;
+
+}
+
+/*******************************************
+ * Historial comprimido de metricas        *
+ *******************************************/
+
+/**
+ * @brief Metricas de componente que se pueden guardar como serie de tiempo.
+ * 
+ */
+enum MetricaComponente {
+    METRICA_ENERGIA,
+    METRICA_CARGA,
+    METRICA_FRECUENCIA,
+    METRICA_VELOCIDAD,
+    METRICA_IOPS,
+    METRICA_LATENCIA,
+    METRICA_TOTAL
+};
+
+/**
+ * @brief Nombre de una metrica tal como se exporta.
+ * 
+ * @param metrica 
+ * @return const char* 
+ */
+inline const char* nombreMetrica(MetricaComponente metrica) {
+
+    static const char* const NOMBRES[METRICA_TOTAL] = {"energia_consumida", "carga_procesamiento", "frecuencia", "velocidad_acceso", "iops", "latencia_promedio"};
+    return metrica < METRICA_TOTAL ? NOMBRES[metrica] : "?";
+
+}
+
+const int PALABRAS_BLOQUE = 32;
+const int BITS_BLOQUE = PALABRAS_BLOQUE * 64;
+// Peor caso de una muestra: 4 + 64 bits de marca de tiempo y 2 + 5 + 5 + 32 bits de valor.
+const int BITS_MAXIMOS_MUESTRA = 112;
+
+/**
+ * @brief Bloque de tamano fijo con muestras comprimidas al estilo Gorilla.
+ * 
+ * La primera marca de tiempo y el primer valor van en la cabecera; el resto se codifica en bits como
+ * diferencia de diferencias de la marca de tiempo y XOR del valor contra el anterior.
+ */
+struct BloqueSerie {
+    int64_t inicio;
+    int64_t fin;
+    uint32_t cantidad;
+    uint32_t primerValor;
+    uint64_t bits[PALABRAS_BLOQUE];
+};
+
+/**
+ * @brief Lector secuencial de las muestras de un bloque.
+ * 
+ */
+class LectorBloque {
+
+    private:
+    const BloqueSerie& bloque;
+    uint32_t posicionBits;
+    uint32_t leidas;
+    int64_t tiempo;
+    int64_t delta;
+    uint32_t valor;
+    int ceroIzquierda;
+    int ceroDerecha;
+
+    uint64_t leer(int cantidad) {
+
+        uint64_t resultado = 0;
+        while (cantidad > 0) {
+            int desplazamiento = posicionBits & 63;
+            int disponibles = 64 - desplazamiento;
+            int tomar = cantidad < disponibles ? cantidad : disponibles;
+            uint64_t palabra = bloque.bits[posicionBits >> 6] << desplazamiento;
+            resultado = (tomar == 64 ? 0 : resultado << tomar) | (palabra >> (64 - tomar));
+            posicionBits += tomar;
+            cantidad -= tomar;
+        }
+        return resultado;
+
+    }
+
+    static int64_t extenderSigno(uint64_t valor, int bits) {
+
+        return static_cast<int64_t>(valor << (64 - bits)) >> (64 - bits);
+
+    }
+
+    public:
+    explicit LectorBloque(const BloqueSerie& _bloque) : bloque(_bloque), posicionBits(0), leidas(0), tiempo(0), delta(0), valor(0), ceroIzquierda(0), ceroDerecha(0) {}
+
+    /**
+     * @brief Decodifica la siguiente muestra.
+     * 
+     * @param _tiempo 
+     * @param _valor 
+     * @return bool false si ya no quedan muestras.
+     */
+    bool siguiente(int64_t& _tiempo, float& _valor) {
+
+        if (leidas == bloque.cantidad) return false;
+        if (leidas == 0) {
+            tiempo = bloque.inicio;
+            valor  = bloque.primerValor;
+        } else {
+            int64_t dod;
+            if (leer(1) == 0)      dod = 0;
+            else if (leer(1) == 0) dod = extenderSigno(leer(7), 7);
+            else if (leer(1) == 0) dod = extenderSigno(leer(9), 9);
+            else if (leer(1) == 0) dod = extenderSigno(leer(12), 12);
+            else                   dod = static_cast<int64_t>(leer(64));
+            delta  += dod;
+            tiempo += delta;
+
+            if (leer(1) == 1) {
+                if (leer(1) == 1) {
+                    ceroIzquierda = static_cast<int>(leer(5));
+                    int significativos = static_cast<int>(leer(5)) + 1;
+                    ceroDerecha = 32 - ceroIzquierda - significativos;
+                }
+                valor ^= static_cast<uint32_t>(leer(32 - ceroIzquierda - ceroDerecha)) << ceroDerecha;
+            }
+        }
+        leidas++;
+        _tiempo = tiempo;
+        std::memcpy(&_valor, &valor, sizeof(float));
+        return true;
+
+    }
+
+};
+
+/**
+ * @brief Resumen de una ventana de una serie.
+ * 
+ */
+struct ResumenVentana {
+    int64_t inicio;
+    float minimo;
+    float maximo;
+    double suma;
+    uint32_t cantidad;
+
+    double promedio() const { return cantidad > 0 ? suma / cantidad : 0.0; }
+};
+
+/**
+ * @brief Serie de tiempo comprimida de una metrica, formada por bloques de tamano fijo.
+ * 
+ * Las marcas de tiempo deben llegar en orden creciente (por ejemplo en milisegundos). Con muestras
+ * regulares la marca de tiempo cuesta un bit y un valor repetido otro bit.
+ */
+class SerieTemporal {
+
+    private:
+    std::vector<BloqueSerie> bloques;
+    uint32_t posicionBits;
+    int64_t delta;
+    uint32_t valorAnterior;
+    int ceroIzquierda;
+    int ceroDerecha;
+
+    void escribir(uint64_t valor, int cantidad) {
+
+        BloqueSerie& bloque = bloques.back();
+        while (cantidad > 0) {
+            int desplazamiento = posicionBits & 63;
+            int disponibles = 64 - desplazamiento;
+            int tomar = cantidad < disponibles ? cantidad : disponibles;
+            uint64_t parte = (valor >> (cantidad - tomar)) & (tomar == 64 ? ~0ull : (1ull << tomar) - 1);
+            bloque.bits[posicionBits >> 6] |= parte << (disponibles - tomar);
+            posicionBits += tomar;
+            cantidad -= tomar;
+        }
+
+    }
+
+    public:
+    SerieTemporal() : posicionBits(0), delta(0), valorAnterior(0), ceroIzquierda(0), ceroDerecha(0) {}
+
+    /**
+     * @brief Agrega una muestra al final de la serie.
+     * 
+     * @param tiempo 
+     * @param valor 
+     * @return bool false si la marca de tiempo no es posterior a la ultima.
+     */
+    bool agregar(int64_t tiempo, float valor) {
+
+        uint32_t bitsValor;
+        std::memcpy(&bitsValor, &valor, sizeof(float));
+
+        if (bloques.empty() || posicionBits + BITS_MAXIMOS_MUESTRA > BITS_BLOQUE) {
+            if (!bloques.empty() && tiempo <= bloques.back().fin) return false;
+            bloques.emplace_back();
+            BloqueSerie& bloque = bloques.back();
+            std::memset(&bloque, 0, sizeof(BloqueSerie));
+            bloque.inicio = bloque.fin = tiempo;
+            bloque.cantidad = 1;
+            bloque.primerValor = bitsValor;
+            posicionBits  = 0;
+            delta         = 0;
+            valorAnterior = bitsValor;
+            ceroIzquierda = ceroDerecha = 0;
+            return true;
+        }
+
+        BloqueSerie& bloque = bloques.back();
+        if (tiempo <= bloque.fin) return false;
+        int64_t nuevoDelta = tiempo - bloque.fin;
+        int64_t dod = nuevoDelta - delta;
+        if (dod == 0)                          escribir(0, 1);
+        else if (dod >= -64 && dod <= 63)      { escribir(0x2, 2);  escribir(static_cast<uint64_t>(dod), 7); }
+        else if (dod >= -256 && dod <= 255)    { escribir(0x6, 3);  escribir(static_cast<uint64_t>(dod), 9); }
+        else if (dod >= -2048 && dod <= 2047)  { escribir(0xE, 4);  escribir(static_cast<uint64_t>(dod), 12); }
+        else                                   { escribir(0xF, 4);  escribir(static_cast<uint64_t>(dod), 64); }
+        delta = nuevoDelta;
+
+        uint32_t xorValor = bitsValor ^ valorAnterior;
+        if (xorValor == 0) {
+            escribir(0, 1);
+        } else {
+            int izquierda = __builtin_clz(xorValor);
+            int derecha   = __builtin_ctz(xorValor);
+            if (ceroIzquierda + ceroDerecha > 0 && izquierda >= ceroIzquierda && derecha >= ceroDerecha) {
+                escribir(0x2, 2);
+                escribir(xorValor >> ceroDerecha, 32 - ceroIzquierda - ceroDerecha);
+            } else {
+                int significativos = 32 - izquierda - derecha;
+                escribir(0x3, 2);
+                escribir(static_cast<uint64_t>(izquierda), 5);
+                escribir(static_cast<uint64_t>(significativos - 1), 5);
+                escribir(xorValor >> derecha, significativos);
+                ceroIzquierda = izquierda;
+                ceroDerecha   = derecha;
+            }
+        }
+        valorAnterior = bitsValor;
+        bloque.fin = tiempo;
+        bloque.cantidad++;
+        return true;
+
+    }
+
+    /**
+     * @brief Recorre las muestras con marca de tiempo en [desde, hasta], saltando los bloques fuera del rango.
+     * 
+     * @param desde 
+     * @param hasta 
+     * @param funcion Recibe (tiempo, valor).
+     */
+    template <class Funcion>
+    void recorrer(int64_t desde, int64_t hasta, Funcion funcion) const {
+
+        auto primero = std::lower_bound(bloques.begin(), bloques.end(), desde, [](const BloqueSerie& b, int64_t t) { return b.fin < t; });
+        for (auto it = primero; it != bloques.end() && it->inicio <= hasta; ++it) {
+            LectorBloque lector(*it);
+            int64_t tiempo;
+            float valor;
+            while (lector.siguiente(tiempo, valor)) {
+                if (tiempo > hasta) return;
+                if (tiempo >= desde) funcion(tiempo, valor);
+            }
+        }
+
+    }
+
+    /**
+     * @brief Reduce el rango [desde, hasta) a ventanas de largo paso con minimo, maximo y promedio.
+     * 
+     * @param desde 
+     * @param hasta 
+     * @param paso 
+     * @return std::vector<ResumenVentana> Solo las ventanas con muestras.
+     */
+    std::vector<ResumenVentana> resumir(int64_t desde, int64_t hasta, int64_t paso) const {
+
+        std::vector<ResumenVentana> ventanas;
+        if (paso <= 0 || hasta <= desde) return ventanas;
+        recorrer(desde, hasta - 1, [&](int64_t tiempo, float valor) {
+            int64_t inicio = desde + (tiempo - desde) / paso * paso;
+            if (ventanas.empty() || ventanas.back().inicio != inicio) ventanas.push_back({inicio, valor, valor, 0.0, 0});
+            ResumenVentana& v = ventanas.back();
+            v.minimo = valor < v.minimo ? valor : v.minimo;
+            v.maximo = valor > v.maximo ? valor : v.maximo;
+            v.suma  += valor;
+            v.cantidad++;
+        });
+        return ventanas;
+
+    }
+
+    size_t cantidadMuestras() const {
+
+        size_t total = 0;
+        for (const BloqueSerie& bloque : bloques) total += bloque.cantidad;
+        return total;
+
+    }
+
+    size_t bytesUsados() const { return bloques.capacity() * sizeof(BloqueSerie); }
+
+    /**
+     * @brief Ajusta la reserva del vector de bloques al tamano usado.
+     * 
+     */
+    void compactar() { bloques.shrink_to_fit(); }
+
+};
+
+/**
+ * @brief Historial de metricas de todos los componentes de un registro, una serie por componente y metrica.
+ * 
+ */
+class AlmacenSeries {
+
+    private:
+    std::vector<SerieTemporal> series[TIPO_COMPONENTE_TOTAL][METRICA_TOTAL];
+
+    /**
+     * @brief Agrega una columna completa del registro a las series de una metrica.
+     * 
+     * @param tipo 
+     * @param metrica 
+     * @param columna 
+     * @param tiempo 
+     */
+    template <class Valor>
+    void agregarColumna(TipoComponente tipo, MetricaComponente metrica, const std::vector<Valor>& columna, int64_t tiempo) {
+
+        std::vector<SerieTemporal>& destino = series[tipo][metrica];
+        if (destino.size() < columna.size()) destino.resize(columna.size());
+        for (size_t i = 0; i < columna.size(); i++) destino[i].agregar(tiempo, static_cast<float>(columna[i]));
+
+    }
+
+    public:
+    /**
+     * @brief Guarda el estado actual del registro con la marca de tiempo indicada.
+     * 
+     * @param registro 
+     * @param tiempo 
+     */
+    void registrarTick(const RegistroComponentes& registro, int64_t tiempo) {
+
+        const ColumnasProcesamiento* procesamiento[] = {&registro.cpus, &registro.gpus};
+        for (int t = TIPO_CPU; t <= TIPO_GPU; t++) {
+            TipoComponente tipo = static_cast<TipoComponente>(t);
+            agregarColumna(tipo, METRICA_ENERGIA, procesamiento[t]->energiaConsumida, tiempo);
+            agregarColumna(tipo, METRICA_CARGA, procesamiento[t]->cargaProcesamiento, tiempo);
+            agregarColumna(tipo, METRICA_FRECUENCIA, procesamiento[t]->frecuencia, tiempo);
+        }
+        const ColumnasAlmacenamiento* almacenamiento[] = {&registro.hdds, &registro.ssds, &registro.sshds};
+        for (int t = TIPO_HDD; t <= TIPO_SSHD; t++) {
+            TipoComponente tipo = static_cast<TipoComponente>(t);
+            const ColumnasAlmacenamiento* c = almacenamiento[t - TIPO_HDD];
+            agregarColumna(tipo, METRICA_ENERGIA, c->energiaConsumida, tiempo);
+            agregarColumna(tipo, METRICA_CARGA, c->cargaProcesamiento, tiempo);
+            agregarColumna(tipo, METRICA_VELOCIDAD, c->velocidadAcceso, tiempo);
+            agregarColumna(tipo, METRICA_IOPS, c->iops, tiempo);
+            agregarColumna(tipo, METRICA_LATENCIA, c->latenciaPromedio, tiempo);
+        }
+
+    }
+
+    /**
+     * @brief Serie de una metrica de un componente.
+     * 
+     * @param m 
+     * @param metrica 
+     * @return const SerieTemporal* nullptr si no hay historial.
+     */
+    const SerieTemporal* serie(ManejadorComponente m, MetricaComponente metrica) const {
+
+        const std::vector<SerieTemporal>& lista = series[m.tipo][metrica];
+        return m.indice < lista.size() ? &lista[m.indice] : nullptr;
+
+    }
+
+    size_t cantidadMuestras() const {
+
+        size_t total = 0;
+        for (const auto& porTipo : series)
+            for (const auto& lista : porTipo)
+                for (const SerieTemporal& s : lista) total += s.cantidadMuestras();
+        return total;
+
+    }
+
+    size_t bytesUsados() const {
+
+        size_t total = 0;
+        for (const auto& porTipo : series)
+            for (const auto& lista : porTipo)
+                for (const SerieTemporal& s : lista) total += s.bytesUsados() + sizeof(SerieTemporal);
+        return total;
+
+    }
+
+    void compactar() {
+
+        for (auto& porTipo : series)
+            for (auto& lista : porTipo)
+                for (SerieTemporal& s : lista) s.compactar();
+
+    }
+
+};
+
+/**
+ * @brief Simula una flota a 1 Hz, guarda su historial y mide compresion, escritura, lectura y resumenes.
+ * 
+ * @param nodos mayor que 0.
+ * @param segundos mayor que 0.
+ */
+void compararSeries(size_t nodos, size_t segundos) {
+
+    // Sin nodos no hay gpu 0 que resumir y sin segundos no hay muestras por las que dividir.
+    if (nodos == 0 || segundos == 0) {
+        std::cerr << "benchmark-series necesita nodos y segundos mayores que 0\n";
+        return;
+    }
+
+    RegistroComponentes registro;
+    generarFlota(registro, nodos);
+    AlmacenSeries almacen;
+
+    // Paseo aleatorio de la carga con un decimal; la energia sigue a la carga y el resto varia poco.
+    uint32_t estado = 88172645u;
+    auto azar = [&estado]() { estado ^= estado << 13; estado ^= estado >> 17; estado ^= estado << 5; return estado; };
+    auto paso = [&](size_t, float& energia, float& carga) {
+        uint32_t r = azar();
+        if ((r & 7) == 0) {
+            carga += static_cast<float>(static_cast<int>(r >> 8) % 21 - 10) * 0.1f;
+            carga = std::round(std::min(100.0f, std::max(0.0f, carga)) * 10.0f) / 10.0f;
+            energia = std::round(energia * 0.9f + carga);
+        }
+    };
+
+    const int64_t INICIO_MS = 1700000000000;
+    double nsEscritura = 0;
+    for (size_t s = 0; s < segundos; s++) {
+        for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) registro.actualizarTick(static_cast<TipoComponente>(t), paso);
+        auto inicio = std::chrono::steady_clock::now();
+        almacen.registrarTick(registro, INICIO_MS + static_cast<int64_t>(s) * 1000);
+        nsEscritura += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+    }
+    almacen.compactar();
+
+    size_t muestras = almacen.cantidadMuestras();
+    size_t bytes = almacen.bytesUsados();
+    double bytesPorMuestra = static_cast<double>(bytes) / muestras;
+    std::cout << "Muestras: " << muestras << ", memoria: " << bytes / 1048576.0 << " MB, " << bytesPorMuestra << " bytes/muestra (sin comprimir 12)\n";
+    std::cout << "Escritura: " << nsEscritura / muestras << " ns/muestra\n";
+    double semana = 7.0 * 86400.0 * (muestras / static_cast<double>(segundos));
+    std::cout << "Proyeccion de una semana a 1 Hz para esta flota: " << semana * bytesPorMuestra / 1048576.0 << " MB\n";
+
+    ManejadorComponente gpu0{TIPO_GPU, 0};
+    const SerieTemporal* serie = almacen.serie(gpu0, METRICA_CARGA);
+    auto inicio = std::chrono::steady_clock::now();
+    size_t leidas = 0;
+    double suma = 0;
+    for (uint32_t i = 0; i < registro.gpus.cantidad(); i++) {
+        almacen.serie({TIPO_GPU, i}, METRICA_CARGA)->recorrer(INICIO_MS, INICIO_MS + static_cast<int64_t>(segundos) * 1000, [&](int64_t, float v) { suma += v; leidas++; });
+    }
+    double nsLectura = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count() / leidas;
+    std::cout << "Lectura: " << nsLectura << " ns/muestra (control " << suma << ")\n";
+
+    std::vector<ResumenVentana> minutos = serie->resumir(INICIO_MS, INICIO_MS + static_cast<int64_t>(segundos) * 1000, 60000);
+    std::cout << "Carga de gpu 0 por minuto:";
+    for (size_t i = 0; i < minutos.size() && i < 5; i++) std::cout << " [" << minutos[i].minimo << ", " << minutos[i].promedio() << ", " << minutos[i].maximo << "]";
+    std::cout << "\n";
+
+}
+
+/*******************************************
+ * Exportacion de metricas por lotes       *
+ *******************************************/
+
+/**
+ * @brief Columna del registro que guarda una metrica para un tipo de componente.
+ * 
+ * @param registro 
+ * @param tipo 
+ * @param metrica 
+ * @return const std::vector<float>* nullptr si el tipo no tiene esa metrica.
+ */
+inline const std::vector<float>* columnaMetrica(const RegistroComponentes& registro, TipoComponente tipo, MetricaComponente metrica) {
+
+    if (metrica == METRICA_ENERGIA) return &registro.columnas(tipo).energiaConsumida;
+    if (metrica == METRICA_CARGA) return &registro.columnas(tipo).cargaProcesamiento;
+    if (tipo == TIPO_CPU || tipo == TIPO_GPU) {
+        const ColumnasProcesamiento& c = tipo == TIPO_CPU ? static_cast<const ColumnasProcesamiento&>(registro.cpus) : registro.gpus;
+        return metrica == METRICA_FRECUENCIA ? &c.frecuencia : nullptr;
+    }
+    const ColumnasAlmacenamiento& c = tipo == TIPO_HDD ? static_cast<const ColumnasAlmacenamiento&>(registro.hdds)
+                                    : tipo == TIPO_SSD ? static_cast<const ColumnasAlmacenamiento&>(registro.ssds) : registro.sshds;
+    switch (metrica) {
+        case METRICA_VELOCIDAD: return &c.velocidadAcceso;
+        case METRICA_IOPS:      return &c.iops;
+        case METRICA_LATENCIA:  return &c.latenciaPromedio;
+        default:                return nullptr;
+    }
+
+}
+
+/**
+ * @brief Formatos de salida del exportador.
+ * 
+ */
+enum FormatoExportacion {
+    EXPORTAR_JSON,
+    EXPORTAR_PROMETHEUS,
+    EXPORTAR_BINARIO
+};
+
+/**
+ * @brief Serializa la flota completa de un registro en un buffer reutilizable y lo escribe con una sola llamada por tick.
+ * 
+ * Formatos:
+ *   - JSON lines: un objeto por componente con su tipo, indice y metricas.
+ *   - Prometheus: exposicion de texto, una familia "componente_<metrica>" por metrica con etiquetas tipo e id.
+ *   - Binario: marco "CMPB", largo total (u32), marca de tiempo (i64) y, por tipo, el tipo (u8), la cantidad
+ *     (u32), la cantidad de metricas (u8) y para cada metrica su numero (u8) seguido de la columna de floats.
+ *     Todo en el orden de bytes de la maquina.
+ * Los numeros se escriben con std::to_chars, sin iostreams ni locale.
+ */
+class ExportadorMetricas {
+
+    private:
+    std::string buffer;
+
+    void agregarEntero(int64_t valor) {
+
+        char texto[24];
+        char* fin = std::to_chars(texto, texto + sizeof(texto), valor).ptr;
+        buffer.append(texto, fin - texto);
+
+    }
+
+    void agregarReal(float valor) {
+
+        char texto[32];
+        char* fin = std::to_chars(texto, texto + sizeof(texto), valor).ptr;
+        buffer.append(texto, fin - texto);
+
+    }
+
+    template <class T>
+    void agregarBinario(const T& valor) {
+
+        buffer.append(reinterpret_cast<const char*>(&valor), sizeof(T));
+
+    }
+
+    void serializarJSON(const RegistroComponentes& registro, int64_t tiempoMs) {
+
+        for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+            TipoComponente tipo = static_cast<TipoComponente>(t);
+            const std::vector<float>* columnas[METRICA_TOTAL];
+            for (int m = 0; m < METRICA_TOTAL; m++) columnas[m] = columnaMetrica(registro, tipo, static_cast<MetricaComponente>(m));
+            size_t n = registro.cantidad(tipo);
+            for (size_t i = 0; i < n; i++) {
+                buffer += "{\"ts\":";
+                agregarEntero(tiempoMs);
+                buffer += ",\"tipo\":\"";
+                buffer += nombreTipo(tipo);
+                buffer += "\",\"id\":";
+                agregarEntero(static_cast<int64_t>(i));
+                for (int m = 0; m < METRICA_TOTAL; m++) {
+                    if (columnas[m] == nullptr) continue;
+                    buffer += ",\"";
+                    buffer += nombreMetrica(static_cast<MetricaComponente>(m));
+                    buffer += "\":";
+                    agregarReal((*columnas[m])[i]);
+                }
+                buffer += "}\n";
+            }
+        }
+
+    }
+
+    void serializarPrometheus(const RegistroComponentes& registro, int64_t tiempoMs) {
+
+        for (int m = 0; m < METRICA_TOTAL; m++) {
+            MetricaComponente metrica = static_cast<MetricaComponente>(m);
+            buffer += "# TYPE componente_";
+            buffer += nombreMetrica(metrica);
+            buffer += " gauge\n";
+            for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+                TipoComponente tipo = static_cast<TipoComponente>(t);
+                const std::vector<float>* columna = columnaMetrica(registro, tipo, metrica);
+                if (columna == nullptr) continue;
+                for (size_t i = 0; i < columna->size(); i++) {
+                    buffer += "componente_";
+                    buffer += nombreMetrica(metrica);
+                    buffer += "{tipo=\"";
+                    buffer += nombreTipo(tipo);
+                    buffer += "\",id=\"";
+                    agregarEntero(static_cast<int64_t>(i));
+                    buffer += "\"} ";
+                    agregarReal((*columna)[i]);
+                    buffer += ' ';
+                    agregarEntero(tiempoMs);
+                    buffer += '\n';
+                }
+            }
+        }
+
+    }
+
+    void serializarBinario(const RegistroComponentes& registro, int64_t tiempoMs) {
+
+        buffer.append("CMPB", 4);
+        agregarBinario<uint32_t>(0);
+        agregarBinario<int64_t>(tiempoMs);
+        for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+            TipoComponente tipo = static_cast<TipoComponente>(t);
+            const std::vector<float>* columnas[METRICA_TOTAL];
+            uint8_t cantidadMetricas = 0;
+            for (int m = 0; m < METRICA_TOTAL; m++) {
+                columnas[m] = columnaMetrica(registro, tipo, static_cast<MetricaComponente>(m));
+                cantidadMetricas += columnas[m] != nullptr;
+            }
+            agregarBinario<uint8_t>(static_cast<uint8_t>(tipo));
+            agregarBinario<uint32_t>(static_cast<uint32_t>(registro.cantidad(tipo)));
+            agregarBinario<uint8_t>(cantidadMetricas);
+            for (int m = 0; m < METRICA_TOTAL; m++) {
+                if (columnas[m] == nullptr) continue;
+                agregarBinario<uint8_t>(static_cast<uint8_t>(m));
+                buffer.append(reinterpret_cast<const char*>(columnas[m]->data()), columnas[m]->size() * sizeof(float));
+            }
+        }
+        uint32_t largo = static_cast<uint32_t>(buffer.size());
+        std::memcpy(&buffer[4], &largo, sizeof(largo));
+
+    }
+
+    public:
+    /**
+     * @brief Serializa el registro, reemplazando el contenido anterior del buffer sin liberar su memoria.
+     * 
+     * @param registro 
+     * @param tiempoMs 
+     * @param formato 
+     * @return const std::string& 
+     */
+    const std::string& serializar(const RegistroComponentes& registro, int64_t tiempoMs, FormatoExportacion formato) {
+
+        buffer.clear();
+        switch (formato) {
+            case EXPORTAR_JSON:       serializarJSON(registro, tiempoMs); break;
+            case EXPORTAR_PROMETHEUS: serializarPrometheus(registro, tiempoMs); break;
+            case EXPORTAR_BINARIO:    serializarBinario(registro, tiempoMs); break;
+        }
+        return buffer;
+
+    }
+
+    /**
+     * @brief Escribe el buffer en un descriptor; normalmente es una sola llamada a write.
+     * 
+     * @param fd Archivo, tuberia o socket.
+     * @return bool false si la escritura falla.
+     */
+    bool escribir(int fd) const {
+
+        const char* datos = buffer.data();
+        size_t pendiente = buffer.size();
+        while (pendiente > 0) {
+            ssize_t escritos = write(fd, datos, pendiente);
+            if (escritos < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            datos += escritos;
+            pendiente -= static_cast<size_t>(escritos);
+        }
+        return true;
+
+    }
+
+    size_t tamano() const { return buffer.size(); }
+
+};
+
+/**
+ * @brief Lee el nombre de un formato de exportacion.
+ * 
+ * @param nombre "json", "prometheus" o "binario".
+ * @param formato 
+ * @return bool 
+ */
+inline bool leerFormatoExportacion(const std::string& nombre, FormatoExportacion& formato) {
+
+    if (nombre == "json")       { formato = EXPORTAR_JSON;       return true; }
+    if (nombre == "prometheus") { formato = EXPORTAR_PROMETHEUS; return true; }
+    if (nombre == "binario")    { formato = EXPORTAR_BINARIO;    return true; }
+    return false;
+
+}
+
+/**
+ * @brief Exporta una flota sintetica a un archivo durante varios ticks en los tres formatos y mide cada uno.
+ * 
+ * @param nodos 
+ * @param ticks 
+ * @param ruta Archivo de destino; por omision /dev/null.
+ */
+void compararExportacion(size_t nodos, int ticks, const char* ruta) {
+
+    RegistroComponentes registro;
+    generarFlota(registro, nodos);
+    int fd = open(ruta, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cout << "No se pudo abrir " << ruta << ": " << std::strerror(errno) << "\n";
+        return;
+    }
+
+    const FormatoExportacion FORMATOS[] = {EXPORTAR_JSON, EXPORTAR_PROMETHEUS, EXPORTAR_BINARIO};
+    const char* const NOMBRES[] = {"json", "prometheus", "binario"};
+    ExportadorMetricas exportador;
+    for (int f = 0; f < 3; f++) {
+        auto inicio = std::chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++) {
+            exportador.serializar(registro, 1700000000000 + t * 1000, FORMATOS[f]);
+            exportador.escribir(fd);
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count() / ticks;
+        std::cout << NOMBRES[f] << ": " << exportador.tamano() / 1024.0 << " KB/tick, " << ms << " ms/tick, "
+                  << ms * 1e6 / registro.cantidadTotal() << " ns/componente\n";
+    }
+    close(fd);
+
+}
+
+/*******************************************
+ * Agregacion paralela de la flota         *
+ *******************************************/
+
+/**
+ * @brief Bosquejo DDSketch para cuantiles con error relativo acotado sobre valores no negativos.
+ * 
+ * Cada valor x > 0 cae en la cubeta ceil(log_gamma(x)), con gamma = (1 + alfa) / (1 - alfa), y todo cuantil
+ * se responde con un error relativo de a lo mas alfa. Las cubetas son un arreglo denso que crece segun el
+ * rango visto; dos bosquejos con el mismo alfa se combinan sumando cubetas, lo que permite acumular por hilo
+ * y fusionar al final.
+ */
+class BosquejoCuantiles {
+
+    private:
+    double gamma;
+    double inversoLogGamma;
+    std::vector<uint64_t> cubetas;
+    int desplazamiento;
+    uint64_t ceros;
+    uint64_t cantidad;
+
+    // Por debajo de este valor se cuenta como cero.
+    static constexpr double MINIMO = 1e-9;
+
+    /**
+     * @brief Asegura que exista la cubeta de un indice, ampliando el arreglo hacia cualquiera de los dos lados.
+     * 
+     * @param indice 
+     * @return uint64_t& 
+     */
+    uint64_t& cubeta(int indice) {
+
+        if (cubetas.empty()) {
+            desplazamiento = indice;
+            cubetas.assign(1, 0);
+        } else if (indice < desplazamiento) {
+            cubetas.insert(cubetas.begin(), static_cast<size_t>(desplazamiento - indice), 0);
+            desplazamiento = indice;
+        } else if (indice - desplazamiento >= static_cast<int>(cubetas.size())) {
+            cubetas.resize(static_cast<size_t>(indice - desplazamiento) + 1, 0);
+        }
+        return cubetas[static_cast<size_t>(indice - desplazamiento)];
+
+    }
+
+    public:
+    /**
+     * @brief Constructor.
+     * 
+     * @param alfa Error relativo tolerado, por omision 1%.
+     */
+    explicit BosquejoCuantiles(double alfa = 0.01) : gamma((1 + alfa) / (1 - alfa)), inversoLogGamma(1.0 / std::log(gamma)), desplazamiento(0), ceros(0), cantidad(0) {}
+
+    void agregar(double valor) {
+
+        cantidad++;
+        if (valor <= MINIMO) {
+            ceros++;
+            return;
+        }
+        cubeta(static_cast<int>(std::ceil(std::log(valor) * inversoLogGamma)))++;
+
+    }
+
+    /**
+     * @brief Suma otro bosquejo creado con el mismo alfa.
+     * 
+     * @param otro 
+     */
+    void combinar(const BosquejoCuantiles& otro) {
+
+        if (!otro.cubetas.empty()) {
+            cubeta(otro.desplazamiento);
+            cubeta(otro.desplazamiento + static_cast<int>(otro.cubetas.size()) - 1);
+            for (size_t i = 0; i < otro.cubetas.size(); i++) cubetas[static_cast<size_t>(otro.desplazamiento - desplazamiento) + i] += otro.cubetas[i];
+        }
+        ceros += otro.ceros;
+        cantidad += otro.cantidad;
+
+    }
+
+    /**
+     * @brief Valor aproximado del cuantil q.
+     * 
+     * @param q Entre 0 y 1.
+     * @return double 
+     */
+    double cuantil(double q) const {
+
+        if (cantidad == 0) return 0.0;
+        uint64_t rango = static_cast<uint64_t>(q * static_cast<double>(cantidad - 1));
+        if (rango < ceros) return 0.0;
+        uint64_t acumulado = ceros;
+        for (size_t i = 0; i < cubetas.size(); i++) {
+            acumulado += cubetas[i];
+            if (acumulado > rango) return 2.0 * std::pow(gamma, desplazamiento + static_cast<int>(i)) / (gamma + 1.0);
+        }
+        return 2.0 * std::pow(gamma, desplazamiento + static_cast<int>(cubetas.size()) - 1) / (gamma + 1.0);
+
+    }
+
+    uint64_t getCantidad() const { return cantidad; }
+
+};
+
+/**
+ * @brief Agregados de la flota: totales, y por tipo la carga promedio y sus percentiles.
+ * 
+ */
+struct AgregadoFlota {
+    double energiaTotal = 0;
+    double anchoBandaAlmacenamiento = 0;
+    size_t cantidad[TIPO_COMPONENTE_TOTAL] = {};
+    double sumaCarga[TIPO_COMPONENTE_TOTAL] = {};
+    BosquejoCuantiles carga[TIPO_COMPONENTE_TOTAL];
+
+    double cargaPromedio(TipoComponente tipo) const { return cantidad[tipo] > 0 ? sumaCarga[tipo] / cantidad[tipo] : 0.0; }
+
+    /**
+     * @brief Suma el parcial de otro hilo.
+     * 
+     * @param otro 
+     */
+    void combinar(const AgregadoFlota& otro) {
+
+        energiaTotal += otro.energiaTotal;
+        anchoBandaAlmacenamiento += otro.anchoBandaAlmacenamiento;
+        for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+            cantidad[t]  += otro.cantidad[t];
+            sumaCarga[t] += otro.sumaCarga[t];
+            carga[t].combinar(otro.carga[t]);
+        }
+
+    }
+};
+
+/**
+ * @brief Acumula en un parcial la porcion [parte/partes] de cada pool del registro.
+ * 
+ * @param registro 
+ * @param parte 
+ * @param partes 
+ * @param parcial 
+ */
+inline void agregarPorcion(const RegistroComponentes& registro, size_t parte, size_t partes, AgregadoFlota& parcial) {
+
+    for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+        TipoComponente tipo = static_cast<TipoComponente>(t);
+        const ColumnasComponente& c = registro.columnas(tipo);
+        size_t n = c.cantidad();
+        size_t desde = n * parte / partes;
+        size_t hasta = n * (parte + 1) / partes;
+        const float* energia = c.energiaConsumida.data();
+        const float* carga   = c.cargaProcesamiento.data();
+        double energiaTotal = 0, sumaCarga = 0;
+        for (size_t i = desde; i < hasta; i++) {
+            energiaTotal += energia[i];
+            sumaCarga    += carga[i];
+            parcial.carga[t].agregar(carga[i]);
+        }
+        parcial.energiaTotal += energiaTotal;
+        parcial.sumaCarga[t] += sumaCarga;
+        parcial.cantidad[t]  += hasta - desde;
+        const std::vector<float>* velocidad = columnaMetrica(registro, tipo, METRICA_VELOCIDAD);
+        if (velocidad != nullptr) {
+            double ancho = 0;
+            for (size_t i = desde; i < hasta; i++) ancho += (*velocidad)[i];
+            parcial.anchoBandaAlmacenamiento += ancho;
+        }
+    }
+
+}
+
+/**
+ * @brief Calcula los agregados de la flota repartiendo cada pool entre varios hilos.
+ * 
+ * Cada hilo acumula en su propio parcial, sin memoria compartida que escribir, y al final el hilo que
+ * llama los combina.
+ * 
+ * @param registro 
+ * @param hilos 0 usa la cantidad de nucleos.
+ * @return AgregadoFlota 
+ */
+AgregadoFlota agregarFlota(const RegistroComponentes& registro, unsigned hilos = 0) {
+
+    if (hilos == 0) hilos = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<AgregadoFlota> parciales(hilos);
+    std::vector<std::thread> trabajadores;
+    for (unsigned h = 1; h < hilos; h++) {
+        trabajadores.emplace_back([&registro, &parciales, h, hilos]() {
+            AgregadoFlota parcial;
+            agregarPorcion(registro, h, hilos, parcial);
+            parciales[h] = std::move(parcial);
+        });
+    }
+    agregarPorcion(registro, 0, hilos, parciales[0]);
+    for (std::thread& trabajador : trabajadores) trabajador.join();
+    for (unsigned h = 1; h < hilos; h++) parciales[0].combinar(parciales[h]);
+    return std::move(parciales[0]);
+
+}
+
+/**
+ * @brief Mide la agregacion de la flota y compara los percentiles del bosquejo con los exactos.
+ * 
+ * @param nodos 
+ * @param hilos 
+ */
+void compararAgregacion(size_t nodos, unsigned hilos) {
+
+    RegistroComponentes registro;
+    generarFlota(registro, nodos);
+
+    auto inicio = std::chrono::steady_clock::now();
+    AgregadoFlota agregado = agregarFlota(registro, hilos);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << "Componentes: " << registro.cantidadTotal() << ", hilos: " << (hilos == 0 ? std::thread::hardware_concurrency() : hilos) << ", " << ms << " ms\n";
+    std::cout << "Energia total: " << agregado.energiaTotal / 1000.0 << " kW, ancho de banda de almacenamiento: " << agregado.anchoBandaAlmacenamiento / 1e6 << " TB/s\n";
+
+    for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+        TipoComponente tipo = static_cast<TipoComponente>(t);
+        std::vector<float> exacto = registro.columnas(tipo).cargaProcesamiento;
+        auto exactoCuantil = [&exacto](double q) {
+            size_t k = static_cast<size_t>(q * (exacto.size() - 1));
+            std::nth_element(exacto.begin(), exacto.begin() + k, exacto.end());
+            return static_cast<double>(exacto[k]);
+        };
+        double p95 = agregado.carga[t].cuantil(0.95), p99 = agregado.carga[t].cuantil(0.99);
+        std::cout << nombreTipo(tipo) << ": carga promedio " << agregado.cargaPromedio(tipo) << "%, p95 " << p95 << "% (exacto " << exactoCuantil(0.95)
+                  << "%), p99 " << p99 << "% (exacto " << exactoCuantil(0.99) << "%)\n";
+    }
+
+}
+
+/*******************************************
+ * Colas sin bloqueo para muestras         *
+ *******************************************/
+
+/**
+ * @brief Registro de tamano fijo con una muestra de un componente.
+ * 
+ * Los valores propios del tipo van en extra: frecuencia y cores en CPU/GPU; velocidadAcceso, iops y
+ * latenciaPromedio en los discos.
+ */
+struct MuestraComponente {
+    uint32_t idComponente;
+    uint32_t tipo;
+    uint64_t marcaTiempoNs;
+    float energiaConsumida;
+    float cargaProcesamiento;
+    float extra[4];
+};
+
+const size_t LINEA_CACHE = 64;
+
+/**
+ * @brief Cola acotada sin bloqueo de un productor y un consumidor.
+ * 
+ * Los indices de productor y consumidor viven en lineas de cache distintas, y cada lado guarda una copia
+ * del indice del otro para leer el atomico compartido solo cuando la cola parece llena o vacia.
+ * 
+ * @tparam T Tipo trivialmente copiable.
+ */
+template <class T>
+class ColaSPSC {
+
+    private:
+    std::vector<T> celdas;
+    size_t mascara;
+    alignas(LINEA_CACHE) std::atomic<size_t> cola;
+    size_t cabezaVista;
+    alignas(LINEA_CACHE) std::atomic<size_t> cabeza;
+    size_t colaVista;
+    char relleno[LINEA_CACHE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    public:
+    /**
+     * @brief Constructor.
+     * 
+     * @param capacidad Se redondea a la siguiente potencia de dos.
+     */
+    explicit ColaSPSC(size_t capacidad) : cola(0), cabezaVista(0), cabeza(0), colaVista(0) {
+
+        size_t tamano = 2;
+        while (tamano < capacidad) tamano <<= 1;
+        celdas.resize(tamano);
+        mascara = tamano - 1;
+        (void)relleno;
+
+    }
+
+    /**
+     * @brief Agrega un elemento. Solo puede llamarla el hilo productor.
+     * 
+     * @param valor 
+     * @return bool false si la cola esta llena.
+     */
+    bool encolar(const T& valor) {
+
+        size_t posicion = cola.load(std::memory_order_relaxed);
+        if (posicion - cabezaVista > mascara) {
+            cabezaVista = cabeza.load(std::memory_order_acquire);
+            if (posicion - cabezaVista > mascara) return false;
+        }
+        celdas[posicion & mascara] = valor;
+        cola.store(posicion + 1, std::memory_order_release);
+        return true;
+
+    }
+
+    /**
+     * @brief Extrae hasta maximo elementos de una vez. Solo puede llamarla el hilo consumidor.
+     * 
+     * @param destino 
+     * @param maximo 
+     * @return size_t Cantidad extraida.
+     */
+    size_t desencolarLote(T* destino, size_t maximo) {
+
+        size_t posicion = cabeza.load(std::memory_order_relaxed);
+        if (colaVista == posicion) {
+            colaVista = cola.load(std::memory_order_acquire);
+            if (colaVista == posicion) return 0;
+        }
+        size_t cantidad = std::min(maximo, colaVista - posicion);
+        for (size_t i = 0; i < cantidad; i++) destino[i] = celdas[(posicion + i) & mascara];
+        cabeza.store(posicion + cantidad, std::memory_order_release);
+        return cantidad;
+
+    }
+
+    size_t capacidad() const { return mascara + 1; }
+
+};
+
+/**
+ * @brief Cola acotada sin bloqueo de varios productores y un consumidor.
+ * 
+ * Cada celda lleva un numero de secuencia (esquema de Vyukov): los productores reservan una posicion con
+ * compare-and-swap sobre la cola y publican la celda avanzando su secuencia; el consumidor, unico, avanza
+ * la cabeza sin operaciones atomicas de lectura-modificacion-escritura y puede extraer lotes completos.
+ * 
+ * @tparam T Tipo trivialmente copiable.
+ */
+template <class T>
+class ColaMPSC {
+
+    private:
+    struct Celda {
+        std::atomic<size_t> secuencia;
+        T valor;
+    };
+
+    std::unique_ptr<Celda[]> celdas;
+    size_t mascara;
+    alignas(LINEA_CACHE) std::atomic<size_t> cola;
+    alignas(LINEA_CACHE) size_t cabeza;
+    char relleno[LINEA_CACHE - sizeof(size_t)];
+
+    public:
+    /**
+     * @brief Constructor.
+     * 
+     * @param capacidad Se redondea a la siguiente potencia de dos.
+     */
+    explicit ColaMPSC(size_t capacidad) : cola(0), cabeza(0) {
+
+        size_t tamano = 2;
+        while (tamano < capacidad) tamano <<= 1;
+        celdas.reset(new Celda[tamano]);
+        for (size_t i = 0; i < tamano; i++) celdas[i].secuencia.store(i, std::memory_order_relaxed);
+        mascara = tamano - 1;
+        (void)relleno;
+
+    }
+
+    /**
+     * @brief Agrega un elemento. Puede llamarse desde cualquier hilo.
+     * 
+     * @param valor 
+     * @return bool false si la cola esta llena.
+     */
+    bool encolar(const T& valor) {
+
+        size_t posicion = cola.load(std::memory_order_relaxed);
+        for (;;) {
+            Celda& celda = celdas[posicion & mascara];
+            size_t secuencia = celda.secuencia.load(std::memory_order_acquire);
+            intptr_t diferencia = static_cast<intptr_t>(secuencia) - static_cast<intptr_t>(posicion);
+            if (diferencia == 0) {
+                if (cola.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed)) {
+                    celda.valor = valor;
+                    celda.secuencia.store(posicion + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diferencia < 0) {
+                return false;
+            } else {
+                posicion = cola.load(std::memory_order_relaxed);
+            }
+        }
+
+    }
+
+    /**
+     * @brief Extrae hasta maximo elementos ya publicados, en orden. Solo puede llamarla el hilo consumidor.
+     * 
+     * @param destino 
+     * @param maximo 
+     * @return size_t Cantidad extraida.
+     */
+    size_t desencolarLote(T* destino, size_t maximo) {
+
+        size_t cantidad = 0;
+        while (cantidad < maximo) {
+            Celda& celda = celdas[cabeza & mascara];
+            if (celda.secuencia.load(std::memory_order_acquire) != cabeza + 1) break;
+            destino[cantidad++] = celda.valor;
+            celda.secuencia.store(cabeza + mascara + 1, std::memory_order_release);
+            cabeza++;
+        }
+        return cantidad;
+
+    }
+
+    size_t capacidad() const { return mascara + 1; }
+
+};
+
+/**
+ * @brief Mide el rendimiento de ColaSPSC y ColaMPSC moviendo muestras entre hilos.
+ * 
+ * @param muestras Muestras por productor.
+ */
+void compararColas(size_t muestras) {
+
+    const size_t LOTE = 256;
+    unsigned nucleos = std::max(1u, std::thread::hardware_concurrency());
+
+    auto informar = [nucleos](const char* nombre, size_t total, unsigned hilos, double segundos, uint64_t control) {
+        double porSegundo = total / segundos;
+        std::cout << nombre << ": " << total << " muestras en " << segundos * 1000 << " ms, " << porSegundo / 1e6
+                  << " M muestras/s, " << porSegundo / std::min(hilos, nucleos) / 1e6 << " M muestras/s por nucleo (control " << control << ")\n";
+    };
+
+    {
+        ColaSPSC<MuestraComponente> cola(16384);
+        uint64_t control = 0;
+        auto inicio = std::chrono::steady_clock::now();
+        std::thread productor([&cola, muestras]() {
+            MuestraComponente muestra{};
+            for (size_t i = 0; i < muestras; i++) {
+                muestra.idComponente  = static_cast<uint32_t>(i);
+                muestra.marcaTiempoNs = i;
+                while (!cola.encolar(muestra)) std::this_thread::yield();
+            }
+        });
+        MuestraComponente lote[LOTE];
+        for (size_t recibidas = 0; recibidas < muestras; ) {
+            size_t n = cola.desencolarLote(lote, LOTE);
+            if (n == 0) { std::this_thread::yield(); continue; }
+            for (size_t i = 0; i < n; i++) control += lote[i].idComponente;
+            recibidas += n;
+        }
+        productor.join();
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        informar("SPSC", muestras, 2, segundos, control);
+    }
+
+    {
+        const unsigned PRODUCTORES = 3;
+        ColaMPSC<MuestraComponente> cola(16384);
+        uint64_t control = 0;
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<std::thread> productores;
+        for (unsigned p = 0; p < PRODUCTORES; p++) {
+            productores.emplace_back([&cola, muestras, p]() {
+                MuestraComponente muestra{};
+                muestra.tipo = p;
+                for (size_t i = 0; i < muestras; i++) {
+                    muestra.idComponente  = static_cast<uint32_t>(i);
+                    muestra.marcaTiempoNs = i;
+                    while (!cola.encolar(muestra)) std::this_thread::yield();
+                }
+            });
+        }
+        MuestraComponente lote[LOTE];
+        size_t total = muestras * PRODUCTORES;
+        for (size_t recibidas = 0; recibidas < total; ) {
+            size_t n = cola.desencolarLote(lote, LOTE);
+            if (n == 0) { std::this_thread::yield(); continue; }
+            for (size_t i = 0; i < n; i++) control += lote[i].idComponente;
+            recibidas += n;
+        }
+        for (std::thread& productor : productores) productor.join();
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        informar("MPSC", total, PRODUCTORES + 1, segundos, control);
+    }
+
+}
+
+/*******************************************
+ * Alertas sobre muestras de componentes   *
+ *******************************************/
+
+/**
+ * @brief Clases de regla de alerta.
+ * 
+ */
+enum ClaseRegla {
+    REGLA_UMBRAL_SOSTENIDO,
+    REGLA_TASA_CAMBIO
+};
+
+/**
+ * @brief Regla de alerta tal como la escribe el usuario.
+ * 
+ * Ejemplos:
+ *   - {TIPO_GPU, METRICA_CARGA, REGLA_UMBRAL_SOSTENIDO, true, 90, 30000}: carga de GPU sobre 90% durante 30 s.
+ *   - {TIPO_HDD, METRICA_LATENCIA, REGLA_TASA_CAMBIO, true, 0.2, 60000}: latencia de HDD que sube mas de 20% por minuto.
+ */
+struct ReglaAlerta {
+    TipoComponente tipo;
+    MetricaComponente metrica;
+    ClaseRegla clase;
+    bool mayorQue;
+    float umbral;
+    int64_t ventanaMs;
+};
+
+/**
+ * @brief Alerta emitida cuando una regla pasa a cumplirse para un componente.
+ * 
+ */
+struct Alerta {
+    uint32_t idRegla;
+    uint32_t tipo;
+    uint32_t idComponente;
+    float valor;
+    uint64_t marcaTiempoNs;
+};
+
+/**
+ * @brief Desplazamiento en bytes del campo de MuestraComponente que lleva una metrica.
+ * 
+ * @param tipo 
+ * @param metrica 
+ * @return int -1 si el tipo no tiene esa metrica.
+ */
+inline int desplazamientoMetrica(TipoComponente tipo, MetricaComponente metrica) {
+
+    bool procesamiento = tipo == TIPO_CPU || tipo == TIPO_GPU;
+    switch (metrica) {
+        case METRICA_ENERGIA:    return offsetof(MuestraComponente, energiaConsumida);
+        case METRICA_CARGA:      return offsetof(MuestraComponente, cargaProcesamiento);
+        case METRICA_FRECUENCIA: return procesamiento ? static_cast<int>(offsetof(MuestraComponente, extra)) : -1;
+        case METRICA_VELOCIDAD:  return procesamiento ? -1 : static_cast<int>(offsetof(MuestraComponente, extra));
+        case METRICA_IOPS:       return procesamiento ? -1 : static_cast<int>(offsetof(MuestraComponente, extra) + sizeof(float));
+        case METRICA_LATENCIA:   return procesamiento ? -1 : static_cast<int>(offsetof(MuestraComponente, extra) + 2 * sizeof(float));
+        default:                 return -1;
+    }
+
+}
+
+/**
+ * @brief Motor de alertas incremental sobre un flujo de MuestraComponente.
+ * 
+ * compilar() traduce las reglas a una tabla plana agrupada por tipo de componente, donde cada entrada ya
+ * tiene el desplazamiento del campo a leer, el umbral y la ventana en nanosegundos; evaluar() solo recorre
+ * las entradas del tipo de la muestra. El estado por regla y componente es de tamano fijo y se actualiza
+ * en O(1) por muestra:
+ *   - umbral sostenido: instante en que empezo la violacion actual.
+ *   - tasa de cambio: la ventana se divide en 16 ranuras y se guarda la primera muestra de cada una; la
+ *     tasa se calcula contra la ranura ocupada mas antigua de la ventana (a lo mas 16 comparaciones) y se
+ *     normaliza al largo de la ventana. Si las muestras son mas espaciadas que una ranura, la referencia
+ *     es la muestra mas antigua que siga dentro de la ventana.
+ * Las alertas se emiten una vez al pasar a cumplirse la condicion y se rearman cuando deja de cumplirse.
+ */
+class MotorAlertas {
+
+    private:
+    static const int RANURAS = 16;
+
+    struct ReglaCompilada {
+        uint32_t idRegla;
+        uint16_t desplazamiento;
+        uint8_t clase;
+        uint8_t mayorQue;
+        float umbral;
+        int64_t ventanaNs;
+        int64_t ranuraNs;
+        uint32_t estado;
+    };
+
+    struct EstadoUmbral {
+        int64_t inicio;
+        bool disparada;
+    };
+
+    struct Ranura {
+        int64_t numero;
+        int64_t tiempo;
+        float valor;
+    };
+
+    struct EstadoTasa {
+        Ranura ranuras[RANURAS];
+        bool disparada;
+    };
+
+    std::vector<ReglaCompilada> tabla;
+    uint32_t inicioTipo[TIPO_COMPONENTE_TOTAL + 1];
+    std::vector<std::vector<EstadoUmbral>> estadosUmbral;
+    std::vector<std::vector<EstadoTasa>> estadosTasa;
+    ColaMPSC<Alerta>& salida;
+    uint64_t descartadas;
+
+    void emitir(const ReglaCompilada& regla, const MuestraComponente& muestra, float valor) {
+
+        if (!salida.encolar(Alerta{regla.idRegla, muestra.tipo, muestra.idComponente, valor, muestra.marcaTiempoNs})) descartadas++;
+
+    }
+
+    public:
+    /**
+     * @brief Constructor.
+     * 
+     * @param _salida Cola donde se dejan las alertas.
+     */
+    explicit MotorAlertas(ColaMPSC<Alerta>& _salida) : salida(_salida), descartadas(0) {
+
+        std::fill(std::begin(inicioTipo), std::end(inicioTipo), 0);
+
+    }
+
+    /**
+     * @brief Compila las reglas a la tabla de evaluacion, descartando el estado anterior.
+     * 
+     * @param reglas El id de cada regla es su posicion en este vector.
+     * @return size_t Cantidad de reglas aceptadas; se omiten las que piden una metrica que el tipo no tiene.
+     */
+    size_t compilar(const std::vector<ReglaAlerta>& reglas) {
+
+        tabla.clear();
+        estadosUmbral.clear();
+        estadosTasa.clear();
+        for (int t = 0; t < TIPO_COMPONENTE_TOTAL; t++) {
+            inicioTipo[t] = static_cast<uint32_t>(tabla.size());
+            for (size_t r = 0; r < reglas.size(); r++) {
+                const ReglaAlerta& regla = reglas[r];
+                int desplazamiento = desplazamientoMetrica(regla.tipo, regla.metrica);
+                if (regla.tipo != t || desplazamiento < 0 || regla.ventanaMs <= 0) continue;
+                ReglaCompilada c;
+                c.idRegla        = static_cast<uint32_t>(r);
+                c.desplazamiento = static_cast<uint16_t>(desplazamiento);
+                c.clase          = static_cast<uint8_t>(regla.clase);
+                c.mayorQue       = regla.mayorQue;
+                c.umbral         = regla.umbral;
+                c.ventanaNs      = regla.ventanaMs * 1000000;
+                c.ranuraNs       = std::max<int64_t>(c.ventanaNs / RANURAS, 1);
+                if (regla.clase == REGLA_UMBRAL_SOSTENIDO) {
+                    c.estado = static_cast<uint32_t>(estadosUmbral.size());
+                    estadosUmbral.emplace_back();
+                } else {
+                    c.estado = static_cast<uint32_t>(estadosTasa.size());
+                    estadosTasa.emplace_back();
+                }
+                tabla.push_back(c);
+            }
+        }
+        inicioTipo[TIPO_COMPONENTE_TOTAL] = static_cast<uint32_t>(tabla.size());
+        return tabla.size();
+
+    }
+
+    /**
+     * @brief Evalua una muestra contra las reglas de su tipo.
+     * 
+     * Las muestras de un mismo componente deben llegar en orden de tiempo.
+     * 
+     * @param muestra 
+     */
+    void evaluar(const MuestraComponente& muestra) {
+
+        if (muestra.tipo >= TIPO_COMPONENTE_TOTAL) return;
+        int64_t ahora = static_cast<int64_t>(muestra.marcaTiempoNs);
+        for (uint32_t r = inicioTipo[muestra.tipo]; r < inicioTipo[muestra.tipo + 1]; r++) {
+            const ReglaCompilada& regla = tabla[r];
+            float valor;
+            std::memcpy(&valor, reinterpret_cast<const char*>(&muestra) + regla.desplazamiento, sizeof(float));
+
+            if (regla.clase == REGLA_UMBRAL_SOSTENIDO) {
+                std::vector<EstadoUmbral>& estados = estadosUmbral[regla.estado];
+                if (muestra.idComponente >= estados.size()) estados.resize(muestra.idComponente + 1, EstadoUmbral{-1, false});
+                EstadoUmbral& estado = estados[muestra.idComponente];
+                bool viola = regla.mayorQue ? valor > regla.umbral : valor < regla.umbral;
+                if (!viola) {
+                    estado.inicio = -1;
+                    estado.disparada = false;
+                    continue;
+                }
+                if (estado.inicio < 0) estado.inicio = ahora;
+                if (!estado.disparada && ahora - estado.inicio >= regla.ventanaNs) {
+                    estado.disparada = true;
+                    emitir(regla, muestra, valor);
+                }
+            } else {
+                std::vector<EstadoTasa>& estados = estadosTasa[regla.estado];
+                if (muestra.idComponente >= estados.size()) {
+                    EstadoTasa vacio{};
+                    for (Ranura& ranura : vacio.ranuras) ranura.numero = -1;
+                    estados.resize(muestra.idComponente + 1, vacio);
+                }
+                EstadoTasa& estado = estados[muestra.idComponente];
+                int64_t numero = ahora / regla.ranuraNs;
+                Ranura& actual = estado.ranuras[numero % RANURAS];
+                if (actual.numero != numero) actual = Ranura{numero, ahora, valor};
+
+                // La ranura valida mas antigua de la ventana. Se recorre desde la que sigue a la actual (la mas
+                // vieja posible) hacia adelante; con muestras densas la primera ya sirve, y con muestras mas
+                // espaciadas que una ranura se salta las vacias o vencidas.
+                const Ranura* antigua = nullptr;
+                for (int k = 1; k < RANURAS && antigua == nullptr; k++) {
+                    const Ranura& ranura = estado.ranuras[(numero + k) % RANURAS];
+                    if (ranura.numero == numero - RANURAS + k) antigua = &ranura;
+                }
+                if (antigua == nullptr || antigua->valor == 0.0f) continue;
+                float tasa = (valor - antigua->valor) / std::fabs(antigua->valor) * static_cast<float>(regla.ventanaNs) / static_cast<float>(ahora - antigua->tiempo);
+                bool viola = regla.mayorQue ? tasa > regla.umbral : tasa < regla.umbral;
+                if (viola && !estado.disparada) emitir(regla, muestra, valor);
+                estado.disparada = viola;
+            }
+        }
+
+    }
+
+    size_t cantidadReglas() const { return tabla.size(); }
+    uint64_t alertasDescartadas() const { return descartadas; }
+
+};
+
+/**
+ * @brief Mide el motor de alertas en un hilo con un flujo sintetico de muestras de GPU y HDD.
+ * 
+ * @param muestras 
+ */
+void compararAlertas(size_t muestras) {
+
+    const uint32_t COMPONENTES = 5000;
+    std::vector<ReglaAlerta> reglas = {
+        {TIPO_GPU, METRICA_CARGA, REGLA_UMBRAL_SOSTENIDO, true, 90.0f, 30000},
+        {TIPO_GPU, METRICA_ENERGIA, REGLA_UMBRAL_SOSTENIDO, true, 300.0f, 10000},
+        {TIPO_HDD, METRICA_LATENCIA, REGLA_TASA_CAMBIO, true, 0.2f, 60000},
+        {TIPO_HDD, METRICA_CARGA, REGLA_UMBRAL_SOSTENIDO, true, 95.0f, 30000},
+        // Ventana de 5 s con muestras a 1 Hz: menos muestras que ranuras.
+        {TIPO_HDD, METRICA_LATENCIA, REGLA_TASA_CAMBIO, true, 0.04f, 5000},
+    };
+    ColaMPSC<Alerta> cola(65536);
+    MotorAlertas motor(cola);
+    motor.compilar(reglas);
+
+    // Cada componente envia una muestra por segundo; la mitad son GPU y la mitad HDD. Las GPU pares
+    // quedan saturadas y la latencia de los HDD multiplos de 10 crece 1% por segundo.
+    std::vector<MuestraComponente> flujo(muestras);
+    for (size_t i = 0; i < muestras; i++) {
+        MuestraComponente& m = flujo[i];
+        uint32_t componente = static_cast<uint32_t>(i % (2 * COMPONENTES));
+        uint64_t segundo = i / (2 * COMPONENTES);
+        m = MuestraComponente{};
+        m.idComponente = componente / 2;
+        m.tipo = componente % 2 == 0 ? TIPO_GPU : TIPO_HDD;
+        m.marcaTiempoNs = segundo * 1000000000ull + componente;
+        if (m.tipo == TIPO_GPU) {
+            m.cargaProcesamiento = m.idComponente % 2 == 0 ? 97.0f : 40.0f + static_cast<float>(m.idComponente % 30);
+            m.energiaConsumida = 250.0f;
+        } else {
+            m.cargaProcesamiento = 30.0f;
+            m.extra[2] = m.idComponente % 10 == 0 ? 5.0f * std::pow(1.01f, static_cast<float>(segundo)) : 5.0f;
+        }
+    }
+
+    Alerta lote[256];
+    size_t recibidas = 0;
+    std::vector<size_t> porRegla(reglas.size(), 0);
+    auto vaciar = [&]() {
+        while (size_t n = cola.desencolarLote(lote, 256)) {
+            for (size_t k = 0; k < n; k++) porRegla[lote[k].idRegla]++;
+            recibidas += n;
+        }
+    };
+    auto inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < muestras; i++) {
+        motor.evaluar(flujo[i]);
+        if ((i & 1023) == 0) vaciar();
+    }
+    vaciar();
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::cout << "Reglas: " << motor.cantidadReglas() << ", muestras: " << muestras << ", " << muestras / segundos / 1e6 << " M muestras/s en un hilo ("
+              << segundos * 1e9 / muestras << " ns/muestra)\n";
+    std::cout << "Alertas: " << recibidas << ", descartadas: " << motor.alertasDescartadas() << ", por regla:";
+    for (size_t r = 0; r < porRegla.size(); r++) std::cout << " " << porRegla[r];
+    std::cout << "\n";
+
+}
+
+/*******************************************
+ * Planificacion de trabajos por carga     *
+ *******************************************/
+
+/**
+ * @brief Politicas de colocacion de trabajos.
+ * 
+ */
+enum PoliticaColocacion {
+    COLOCAR_PRIMER_AJUSTE,
+    COLOCAR_MEJOR_AJUSTE,
+    COLOCAR_MENOS_CARGADO
+};
+
+/**
+ * @brief Trabajo a colocar sobre un componente de procesamiento.
+ * 
+ */
+struct SolicitudTrabajo {
+    TipoComponente tipo;
+    int cores;
+    float anchoBanda;
+    float cargaEsperada;
+};
+
+/**
+ * @brief Lugar donde quedo un trabajo; se devuelve al planificador para liberarlo.
+ * 
+ */
+struct Asignacion {
+    TipoComponente tipo;
+    uint32_t indice;
+    int cores;
+    float anchoBanda;
+    float cargaEsperada;
+};
+
+/**
+ * @brief Planificador que coloca trabajos sobre las CPU y GPU de un registro y mantiene su carga al dia.
+ * 
+ * Cada componente ofrece sus cores y, en las GPU, su ancho de banda de memoria. Al colocar o liberar un
+ * trabajo se descuentan o devuelven esos recursos y cargaProcesamiento del registro pasa a ser
+ * 100 * sum(cores * cargaEsperada) / cores del componente. Politicas:
+ *   - primer ajuste: el componente de menor indice con cores suficientes (arbol de segmentos de maximos).
+ *     Llegar al candidato es O(log n); si le falta ancho de banda se sigue con una busqueda lineal.
+ *   - mejor ajuste: el que queda con menos cores libres tras colocar (conjunto ordenado por cores libres).
+ *     El primer candidato se ubica en O(log n); los que no tienen ancho de banda se recorren uno a uno.
+ *   - menos cargado: el de menor carga que tenga cores suficientes (conjunto ordenado por carga). Se
+ *     recorre desde el menos cargado, asi que es O(n) en el peor caso cuando los menos cargados estan llenos.
+ * El orden por carga usa la carga que lleva el propio planificador, no la columna del registro, que
+ * otros escritores (muestreadores, actualizarDesde) pueden pisar.
+ */
+class PlanificadorCarga {
+
+    private:
+    struct EstadoPool {
+        std::vector<int> coresLibres;
+        std::vector<float> anchoLibre;
+        std::vector<float> cargaCores;
+        std::vector<int> coresTotales;
+        std::vector<int> arbol;
+        size_t hojas = 1;
+        std::set<std::pair<int, uint32_t>> porLibres;
+        std::set<std::pair<float, uint32_t>> porCarga;
+    };
+
+    RegistroComponentes& registro;
+    PoliticaColocacion politica;
+    EstadoPool pools[2];
+
+    static int indicePool(TipoComponente tipo) { return tipo == TIPO_GPU ? 1 : 0; }
+
+    ColumnasProcesamiento& columnas(TipoComponente tipo) { return tipo == TIPO_GPU ? static_cast<ColumnasProcesamiento&>(registro.gpus) : registro.cpus; }
+
+    static float carga(const EstadoPool& pool, uint32_t i) {
+        return pool.coresTotales[i] > 0 ? 100.0f * std::max(pool.cargaCores[i], 0.0f) / pool.coresTotales[i] : 0.0f;
+    }
+
+    void actualizarArbol(EstadoPool& pool, uint32_t i) {
+
+        size_t nodo = pool.hojas + i;
+        pool.arbol[nodo] = pool.coresLibres[i];
+        for (nodo >>= 1; nodo > 0; nodo >>= 1) pool.arbol[nodo] = std::max(pool.arbol[2 * nodo], pool.arbol[2 * nodo + 1]);
+
+    }
+
+    /**
+     * @brief Indice mas bajo con al menos cores libres, descendiendo por el arbol de maximos.
+     * 
+     * @param pool 
+     * @param cores 
+     * @param anchoBanda 
+     * @return int64_t -1 si ninguno alcanza.
+     */
+    int64_t primerAjuste(const EstadoPool& pool, int cores, float anchoBanda) const {
+
+        if (pool.arbol[1] < cores) return -1;
+        // Descenso al primer candidato; si le falta ancho de banda se sigue con una busqueda lineal desde ahi.
+        size_t nodo = 1;
+        while (nodo < pool.hojas) nodo = pool.arbol[2 * nodo] >= cores ? 2 * nodo : 2 * nodo + 1;
+        for (size_t i = nodo - pool.hojas; i < pool.coresLibres.size(); i++) {
+            if (pool.coresLibres[i] >= cores && pool.anchoLibre[i] >= anchoBanda) return static_cast<int64_t>(i);
+        }
+        return -1;
+
+    }
+
+    void modificar(TipoComponente tipo, uint32_t i, int cores, float anchoBanda, float cargaCores) {
+
+        EstadoPool& pool = pools[indicePool(tipo)];
+        ColumnasProcesamiento& c = columnas(tipo);
+        pool.porLibres.erase({pool.coresLibres[i], i});
+        pool.porCarga.erase({carga(pool, i), i});
+        pool.coresLibres[i] += cores;
+        pool.anchoLibre[i]  += anchoBanda;
+        pool.cargaCores[i]  += cargaCores;
+        c.cargaProcesamiento[i] = carga(pool, i);
+        pool.porLibres.insert({pool.coresLibres[i], i});
+        pool.porCarga.insert({carga(pool, i), i});
+        actualizarArbol(pool, i);
+
+    }
+
+    public:
+    /**
+     * @brief Constructor que toma la capacidad actual de las CPU y GPU del registro como libre.
+     * 
+     * @param _registro 
+     * @param _politica 
+     */
+    PlanificadorCarga(RegistroComponentes& _registro, PoliticaColocacion _politica) : registro(_registro), politica(_politica) {
+
+        for (TipoComponente tipo : {TIPO_CPU, TIPO_GPU}) {
+            EstadoPool& pool = pools[indicePool(tipo)];
+            ColumnasProcesamiento& c = columnas(tipo);
+            size_t n = c.cantidad();
+            pool.coresLibres = c.cores;
+            pool.coresTotales = c.cores;
+            pool.anchoLibre.assign(n, std::numeric_limits<float>::infinity());
+            if (tipo == TIPO_GPU) pool.anchoLibre = registro.gpus.memoria;
+            pool.cargaCores.assign(n, 0.0f);
+            while (pool.hojas < std::max<size_t>(n, 1)) pool.hojas <<= 1;
+            pool.arbol.assign(2 * pool.hojas, std::numeric_limits<int>::min());
+            for (uint32_t i = 0; i < n; i++) {
+                c.cargaProcesamiento[i] = 0.0f;
+                pool.porLibres.insert({pool.coresLibres[i], i});
+                pool.porCarga.insert({0.0f, i});
+                pool.arbol[pool.hojas + i] = pool.coresLibres[i];
+            }
+            for (size_t nodo = pool.hojas - 1; nodo > 0; nodo--) pool.arbol[nodo] = std::max(pool.arbol[2 * nodo], pool.arbol[2 * nodo + 1]);
+        }
+
+    }
+
+    /**
+     * @brief Coloca un trabajo segun la politica y actualiza la carga del componente elegido.
+     * 
+     * @param solicitud 
+     * @param asignacion 
+     * @return bool false si ningun componente tiene recursos suficientes.
+     */
+    bool colocar(const SolicitudTrabajo& solicitud, Asignacion& asignacion) {
+
+        if (solicitud.tipo != TIPO_CPU && solicitud.tipo != TIPO_GPU) return false;
+        const EstadoPool& pool = pools[indicePool(solicitud.tipo)];
+        if (pool.arbol[1] < solicitud.cores) return false;
+        int64_t elegido = -1;
+        if (politica == COLOCAR_PRIMER_AJUSTE) {
+            elegido = primerAjuste(pool, solicitud.cores, solicitud.anchoBanda);
+        } else if (politica == COLOCAR_MEJOR_AJUSTE) {
+            for (auto it = pool.porLibres.lower_bound({solicitud.cores, 0}); it != pool.porLibres.end(); ++it) {
+                if (pool.anchoLibre[it->second] >= solicitud.anchoBanda) { elegido = it->second; break; }
+            }
+        } else {
+            for (auto it = pool.porCarga.begin(); it != pool.porCarga.end(); ++it) {
+                if (pool.coresLibres[it->second] >= solicitud.cores && pool.anchoLibre[it->second] >= solicitud.anchoBanda) { elegido = it->second; break; }
+            }
+        }
+        if (elegido < 0) return false;
+
+        uint32_t i = static_cast<uint32_t>(elegido);
+        float cargaCores = solicitud.cores * solicitud.cargaEsperada;
+        modificar(solicitud.tipo, i, -solicitud.cores, -solicitud.anchoBanda, cargaCores);
+        asignacion = Asignacion{solicitud.tipo, i, solicitud.cores, solicitud.anchoBanda, cargaCores};
+        return true;
+
+    }
+
+    /**
+     * @brief Devuelve los recursos de un trabajo terminado.
+     * 
+     * @param asignacion 
+     */
+    void liberar(const Asignacion& asignacion) {
+
+        modificar(asignacion.tipo, asignacion.indice, asignacion.cores, asignacion.anchoBanda, -asignacion.cargaEsperada);
+
+    }
+
+    /**
+     * @brief Cores ocupados de un tipo en toda la flota.
+     * 
+     * @param tipo 
+     * @return int64_t 
+     */
+    int64_t coresOcupados(TipoComponente tipo) {
+
+        const EstadoPool& pool = pools[indicePool(tipo)];
+        const std::vector<int>& total = pool.coresTotales;
+        int64_t ocupados = 0;
+        for (size_t i = 0; i < total.size(); i++) ocupados += total[i] - pool.coresLibres[i];
+        return ocupados;
+
+    }
+
+};
+
+/**
+ * @brief Resultado de simular una politica de colocacion.
+ * 
+ */
+struct ResultadoSimulacion {
+    double makespan;
+    double utilizacion[2];
+    double esperaPromedio;
+    double colocacionesPorSegundo;
+};
+
+/**
+ * @brief Simula por eventos la llegada de trabajos a una flota con una politica y mide el resultado.
+ * 
+ * Los trabajos llegan en orden; cada tipo tiene una fila FIFO y cuando el primero no cabe espera a que
+ * termine algun trabajo.
+ * 
+ * @param nodos 
+ * @param solicitudes 
+ * @param llegadas Instante de llegada de cada solicitud.
+ * @param duraciones 
+ * @param politica 
+ * @return ResultadoSimulacion 
+ */
+ResultadoSimulacion simularColocacion(size_t nodos, const std::vector<SolicitudTrabajo>& solicitudes, const std::vector<double>& llegadas,
+                                      const std::vector<double>& duraciones, PoliticaColocacion politica) {
+
+    RegistroComponentes registro;
+    generarFlota(registro, nodos);
+    PlanificadorCarga planificador(registro, politica);
+
+    typedef std::pair<double, size_t> Evento;
+    std::priority_queue<Evento, std::vector<Evento>, std::greater<Evento>> terminos;
+    std::vector<Asignacion> asignaciones(solicitudes.size());
+    std::deque<size_t> filas[2];
+    double capacidad[2] = {0, 0};
+    for (int c : registro.cpus.cores) capacidad[0] += c;
+    for (int c : registro.gpus.cores) capacidad[1] += c;
+
+    double ahora = 0, coresSegundo[2] = {0, 0}, esperaTotal = 0;
+    int64_t ocupados[2] = {0, 0};
+    size_t siguiente = 0, colocaciones = 0;
+    double nsColocacion = 0;
+
+    auto avanzar = [&](double hasta) {
+        coresSegundo[0] += ocupados[0] * (hasta - ahora);
+        coresSegundo[1] += ocupados[1] * (hasta - ahora);
+        ahora = hasta;
+    };
+    auto intentar = [&](int f) {
+        while (!filas[f].empty()) {
+            size_t j = filas[f].front();
+            auto inicio = std::chrono::steady_clock::now();
+            bool colocado = planificador.colocar(solicitudes[j], asignaciones[j]);
+            nsColocacion += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - inicio).count();
+            colocaciones++;
+            if (!colocado) return;
+            filas[f].pop_front();
+            ocupados[f] += solicitudes[j].cores;
+            esperaTotal += ahora - llegadas[j];
+            terminos.push({ahora + duraciones[j], j});
+        }
+    };
+
+    while (siguiente < solicitudes.size() || !terminos.empty()) {
+        bool llega = siguiente < solicitudes.size() && (terminos.empty() || llegadas[siguiente] <= terminos.top().first);
+        if (llega) {
+            avanzar(llegadas[siguiente]);
+            int f = solicitudes[siguiente].tipo == TIPO_GPU ? 1 : 0;
+            filas[f].push_back(siguiente++);
+            if (filas[f].size() == 1) intentar(f);
+        } else {
+            Evento termino = terminos.top();
+            terminos.pop();
+            avanzar(termino.first);
+            const Asignacion& a = asignaciones[termino.second];
+            int f = a.tipo == TIPO_GPU ? 1 : 0;
+            ocupados[f] -= a.cores;
+            planificador.liberar(a);
+            intentar(f);
+        }
+    }
+
+    ResultadoSimulacion resultado;
+    resultado.makespan = ahora;
+    resultado.utilizacion[0] = ahora > 0 ? coresSegundo[0] / (capacidad[0] * ahora) : 0;
+    resultado.utilizacion[1] = ahora > 0 ? coresSegundo[1] / (capacidad[1] * ahora) : 0;
+    resultado.esperaPromedio = solicitudes.empty() ? 0 : esperaTotal / solicitudes.size();
+    resultado.colocacionesPorSegundo = nsColocacion > 0 ? colocaciones / (nsColocacion / 1e9) : 0;
+    return resultado;
+
+}
+
+/**
+ * @brief Compara las politicas de colocacion sobre el mismo flujo de trabajos.
+ * 
+ * La tasa de llegada se ajusta para pedir en promedio un poco mas del 100% de los cores de CPU, de modo
+ * que se formen filas y las politicas se diferencien por la fragmentacion que dejan.
+ * 
+ * @param nodos 
+ * @param trabajos 
+ */
+void compararPlanificacion(size_t nodos, size_t trabajos) {
+
+    std::mt19937_64 generador(5);
+    std::uniform_real_distribution<double> uniforme(0.0, 1.0);
+    std::exponential_distribution<double> duracion(1.0 / 60.0);
+    double tasa = 1.05 * 16.0 * nodos / (0.8 * 4.5 * 60.0);
+    std::exponential_distribution<double> intervalo(tasa);
+
+    std::vector<SolicitudTrabajo> solicitudes(trabajos);
+    std::vector<double> llegadas(trabajos), duraciones(trabajos);
+    double t = 0;
+    for (size_t i = 0; i < trabajos; i++) {
+        t += intervalo(generador);
+        llegadas[i] = t;
+        duraciones[i] = duracion(generador);
+        if (uniforme(generador) < 0.8) {
+            solicitudes[i] = {TIPO_CPU, 1 + static_cast<int>(generador() % 8), 0.0f, 0.5f + 0.5f * static_cast<float>(uniforme(generador))};
+        } else {
+            solicitudes[i] = {TIPO_GPU, 512 * (1 + static_cast<int>(generador() % 8)), 50.0f + 350.0f * static_cast<float>(uniforme(generador)), 0.5f + 0.5f * static_cast<float>(uniforme(generador))};
+        }
+    }
+
+    const PoliticaColocacion POLITICAS[] = {COLOCAR_PRIMER_AJUSTE, COLOCAR_MEJOR_AJUSTE, COLOCAR_MENOS_CARGADO};
+    const char* const NOMBRES[] = {"primer ajuste", "mejor ajuste", "menos cargado"};
+    std::cout << "Nodos: " << nodos << ", trabajos: " << trabajos << ", ultima llegada: " << t << " s\n";
+    for (int p = 0; p < 3; p++) {
+        ResultadoSimulacion r = simularColocacion(nodos, solicitudes, llegadas, duraciones, POLITICAS[p]);
+        std::cout << NOMBRES[p] << ": makespan " << r.makespan << " s, utilizacion CPU " << r.utilizacion[0] * 100 << "%, GPU "
+                  << r.utilizacion[1] * 100 << "%, espera promedio " << r.esperaPromedio << " s, " << r.colocacionesPorSegundo / 1e6 << " M colocaciones/s\n";
+    }
+
+}
+
+/**
+ * @brief Muestra el estado de un componente de cada tipo.
+ * 
+ */
+void pruebas() {
+    CPU cpu(70, 40, 3.5, 8, 1, 16);
+    GPU gpu(130, 60, 1.5, 2048, 448);
+    HDD hdd(9, 30, 1000, 150, "SATA", 7200, 64);
+    SSD ssd(2.5, 20, 500, 550, "NVMe", "TLC");
+    SSHD sshd(9, 50, 2000, 200, "SATA", 7200, 64, "MLC");
+
+    std::cout << "Estado del CPU: " << "\n";
+    cpu.estadoProcesamiento();
+    cpu.mostrarEstado();
+    std::cout << "\nEstado de la GPU: " << "\n";
+    gpu.estadoProcesamiento();
+    gpu.mostrarEstado();
+    std::cout << "\nEstado del HDD: " << "\n";
+    hdd.estadoAlmacenamiento();
+    hdd.mostrarEstado();
+    std::cout << "\nEstado del SSD: " << "\n";
+    ssd.estadoAlmacenamiento();
+    ssd.mostrarEstado();
+    std::cout << "\nEstado del SSHD: " << "\n";
+    sshd.estadoAlmacenamiento();
+    sshd.mostrarEstado();
+}
+
+/**
+ * @brief Función principal.
+ * 
+ * Sin argumentos crea y muestra el estado de varios componentes de procesamiento y almacenamiento.
+ * Con "monitor-cpu [ticks] [intervalo_ms]" muestrea la CPU de la maquina y con
+ * "monitor-disco <dispositivo> [ticks] [intervalo_ms]" uno de sus discos. "benchmark-registro [nodos]"
+ * compara el registro por columnas con objetos individuales y "simular-sshd [accesos]" las politicas del
+ * nivel SSD de un SSHD. "benchmark-colas [muestras]" mide las colas sin bloqueo y "benchmark-series [nodos] [segundos]"
+ * el historial comprimido. "exportar <json|prometheus|binario> [nodos]" escribe un tick de una flota sintetica
+ * en la salida estandar y "benchmark-exportar [nodos] [ticks] [archivo]" mide los tres formatos.
+ * "benchmark-agregacion [nodos] [hilos]" calcula los agregados de la flota y "benchmark-alertas [muestras]"
+ * mide el motor de alertas. "simular-planificacion [nodos] [trabajos]" compara las politicas de colocacion.
+ * 
+ * @return int
+ */
+int main(int argc, char* argv[]) {
+    std::string modo = argc >= 2 ? argv[1] : "";
+    FormatoExportacion formato;
+    if (modo == "monitor-cpu") {
+        monitorearCPU(argc >= 3 ? std::atoi(argv[2]) : 5, argc >= 4 ? std::atoi(argv[3]) : 1000);
+    } else if (modo == "benchmark-registro") {
+        compararRegistro(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 200000);
+    } else if (modo == "simular-sshd") {
+        simularSSHD(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 5000000);
+    } else if (modo == "benchmark-colas") {
+        compararColas(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+    } else if (modo == "benchmark-series") {
+        compararSeries(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 1000, argc >= 4 ? std::strtoull(argv[3], nullptr, 10) : 3600);
+    } else if (modo == "exportar" && argc >= 3 && leerFormatoExportacion(argv[2], formato)) {
+        RegistroComponentes registro;
+        generarFlota(registro, argc >= 4 ? std::strtoull(argv[3], nullptr, 10) : 2);
+        ExportadorMetricas exportador;
+        exportador.serializar(registro, 1700000000000, formato);
+        return exportador.escribir(STDOUT_FILENO) ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else if (modo == "benchmark-exportar") {
+        compararExportacion(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 10000, argc >= 4 ? std::atoi(argv[3]) : 20, argc >= 5 ? argv[4] : "/dev/null");
+    } else if (modo == "benchmark-agregacion") {
+        compararAgregacion(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 200000, argc >= 4 ? std::atoi(argv[3]) : 0);
+    } else if (modo == "benchmark-alertas") {
+        compararAlertas(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 2000000);
+    } else if (modo == "simular-planificacion") {
+        compararPlanificacion(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 1000, argc >= 4 ? std::strtoull(argv[3], nullptr, 10) : 1000000);
+    } else if (modo == "monitor-disco" && argc >= 3) {
+        monitorearDisco(argv[2], argc >= 4 ? std::atoi(argv[3]) : 5, argc >= 5 ? std::atoi(argv[4]) : 1000);
+    } else {
+        pruebas();
+    }
 
     return 0;
 }
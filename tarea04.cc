@@ -1,6 +1,128 @@
 #include <iostream>
 #include <string>
 #include <cstdlib>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+#include <compare>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <thread>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Dias de cada mes (indice 1 a 12) para un año comun [0] y uno bisiesto [1].
+ * 
+ */
+constexpr int DIAS_POR_MES[2][13] = {
+    { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
+    { 0, 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 }
+};
+
+/**
+ * @brief Dias transcurridos del año antes del primer dia de cada mes (indice 1 a 12).
+ * 
+ */
+constexpr int DIAS_ACUMULADOS[2][13] = {
+    { 0, 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 },
+    { 0, 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335 }
+};
+
+/**
+ * @brief Tamaño de buffer suficiente para cualquier formato de escribirFecha, escribirTiempo o escribirISO8601.
+ * 
+ */
+constexpr int LARGO_MAX_FORMATO = 32;
+
+/**
+ * @brief Pares de digitos "00" a "99" para formatear de a dos digitos a la vez.
+ * 
+ */
+constexpr char PARES_DIGITOS[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/**
+ * @brief Escribe un valor entre 0 y 99 como dos digitos.
+ * 
+ * @param destino 
+ * @param v 
+ * @return char* 
+ */
+inline char* escribirDosDigitos(char* destino, int v) {
+    const char* par = &PARES_DIGITOS[((unsigned)v % 100) * 2];
+    destino[0] = par[0];
+    destino[1] = par[1];
+    return destino + 2;
+}
+
+/**
+ * @brief Escribe un año con cuatro digitos (0000 a 9999); fuera de ese rango usa signo y los digitos necesarios.
+ * 
+ * @param destino 
+ * @param anio 
+ * @return char* 
+ */
+inline char* escribirAnio(char* destino, int anio) {
+    if ((unsigned)anio < 10000) {
+        destino = escribirDosDigitos(destino, anio / 100);
+        return escribirDosDigitos(destino, anio % 100);
+    }
+    int64_t v = anio;
+    if (v < 0) {
+        *destino++ = '-';
+        v = -v;
+    }
+    char tmp[12];
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    while (n > 0) {
+        *destino++ = tmp[--n];
+    }
+    return destino;
+}
+
+/**
+ * @brief Convierte un caracter a digito y acumula en malo si no es '0' a '9' (sin ramas).
+ * 
+ * @param c 
+ * @param malo 
+ * @return uint32_t 
+ */
+constexpr uint32_t leerDigito(char c, uint32_t& malo) {
+    uint32_t v = (uint32_t)(unsigned char)c - '0';
+    malo |= (uint32_t)(v > 9);
+    return v;
+}
+
+/**
+ * @brief Tiempo transcurrido entre dos fechas, normalizado en años, meses, dias, horas, minutos y segundos.
+ * 
+ */
+struct Duracion {
+    int anios    = 0;
+    int meses    = 0;
+    int dias     = 0;
+    int horas    = 0;
+    int minutos  = 0;
+    int segundos = 0;
+};
 
 /**
  * @brief Clase Base.
@@ -20,44 +142,132 @@ class Fecha{
      * @param _mes 
      * @param _anio 
      */
-    Fecha(int _dia, int _mes, int _anio) {
-        dia  = _dia;
-        mes  = _mes;
-        anio = _anio;
+    constexpr Fecha(int _dia, int _mes, int _anio)
+        : dia(_dia), mes(_mes), anio(_anio) {}
+
+    /**
+     * @brief Crea una Fecha validada; una fecha invalida en un contexto constexpr es un error de compilacion.
+     * 
+     * @param _dia 
+     * @param _mes 
+     * @param _anio 
+     * @return Fecha 
+     */
+    static constexpr Fecha crear(int _dia, int _mes, int _anio) {
+        return esFechaValida(_dia, _mes, _anio) ? Fecha(_dia, _mes, _anio)
+                                                : throw std::invalid_argument("Fecha invalida");
+    }
+
+    /**
+     * @brief Indica si un año es bisiesto.
+     * 
+     * @param a 
+     * @return true 
+     * @return false 
+     */
+    static constexpr bool esBisiesto(int a) {
+        return a % 4 == 0 && (a % 100 != 0 || a % 400 == 0);
+    }
+
+    /**
+     * @brief Indica si dia, mes y año forman una fecha valida.
+     * 
+     * @param d 
+     * @param m 
+     * @param a 
+     * @return true 
+     * @return false 
+     */
+    static constexpr bool esFechaValida(int d, int m, int a) {
+        return m >= 1 && m <= 12 && d >= 1 && d <= diasEnMes(m, a);
+    }
+
+    /**
+     * @brief Indica si el objeto actual es una fecha valida.
+     * 
+     * @return true 
+     * @return false 
+     */
+    constexpr bool esValida() const {
+        return esFechaValida(dia, mes, anio);
+    }
+
+    /**
+     * @brief Convierte una fecha civil al numero de dias desde el 01/01/1970 (puede ser negativo).
+     * 
+     * Usa aritmetica cerrada sobre eras de 400 años, sin ciclos.
+     * 
+     * @param d 
+     * @param m 
+     * @param a 
+     * @return int 
+     */
+    static constexpr int serialDesdeCivil(int d, int m, int a) {
+        a -= m <= 2;
+        const int era      = (a >= 0 ? a : a - 399) / 400;
+        const unsigned yoe = (unsigned)(a - era * 400);                           // [0, 399]
+        const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;     // [0, 365]
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;               // [0, 146096]
+        return era * 146097 + (int)doe - 719468;
+    }
+
+    /**
+     * @brief Convierte un numero de dias desde el 01/01/1970 a dia, mes y año.
+     * 
+     * @param serial 
+     * @param d 
+     * @param m 
+     * @param a 
+     */
+    static constexpr void civilDesdeSerial(int serial, int& d, int& m, int& a) {
+        serial += 719468;
+        const int era      = (serial >= 0 ? serial : serial - 146096) / 146097;
+        const unsigned doe = (unsigned)(serial - era * 146097);                         // [0, 146096]
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;     // [0, 399]
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                   // [0, 365]
+        const unsigned mp  = (5 * doy + 2) / 153;                                       // [0, 11]
+        d = (int)(doy - (153 * mp + 2) / 5 + 1);
+        m = (int)(mp < 10 ? mp + 3 : mp - 9);
+        a = (int)yoe + era * 400 + (m <= 2);
+    }
+
+    /**
+     * @brief Crea una Fecha a partir de su numero de dias desde el 01/01/1970.
+     * 
+     * @param serial 
+     * @return Fecha 
+     */
+    static constexpr Fecha desdeSerial(int serial) {
+        int d = 0, m = 0, a = 0;
+        civilDesdeSerial(serial, d, m, a);
+        return Fecha(d, m, a);
+    }
+
+    /**
+     * @brief Devuelve el numero de dias desde el 01/01/1970.
+     * 
+     * @return int 
+     */
+    constexpr int diaSerial() const {
+        return serialDesdeCivil(dia, mes, anio);
     }
 
     /**
-     * @brief Metodo usado para ajustar el mes y el año cuando se exceden.
+     * @brief Suma dias en tiempo constante, ajustando mes y año.
      * 
      * @param dias 
      */
-    void agregarDias(int dias) {
-        dia += dias;
-        while (dia > diasEnMes(mes, anio)) {
-            dia -= diasEnMes(mes, anio);
-            mes++;
-            if (mes > 12) {
-                mes = 1;
-                anio++;
-            }
-        }
+    constexpr void agregarDias(int dias) {
+        civilDesdeSerial(diaSerial() + dias, dia, mes, anio);
     }
 
     /**
-     * @brief Metodo usado para ajustar el mes y el año cuando los dias son negativos.
+     * @brief Resta dias en tiempo constante, ajustando mes y año.
      * 
      * @param dias 
      */
-    void restarDias(int dias) {
-        dia -= dias;
-        while (dia <= 0) {
-            mes--;
-            if (mes < 1) {
-                mes = 12;
-                anio--;
-            }
-            dia += diasEnMes(mes, anio);
-        }
+    constexpr void restarDias(int dias) {
+        civilDesdeSerial(diaSerial() - dias, dia, mes, anio);
     }
 
     /**
@@ -66,7 +276,7 @@ class Fecha{
      * @param otra 
      * @return int 
      */
-    int diferenciaAnios(const Fecha& otra) const {
+    constexpr int diferenciaAnios(const Fecha& otra) const {
         if (this->anio > otra.anio) {
             return this->anio - otra.anio;
         } else {
@@ -80,7 +290,7 @@ class Fecha{
      * @param otra 
      * @return int 
      */
-    int diferenciaMeses(const Fecha& otra) const {
+    constexpr int diferenciaMeses(const Fecha& otra) const {
         if (this->mes > otra.mes) {
             return this->mes - otra.mes;
         } else {
@@ -94,7 +304,7 @@ class Fecha{
      * @param otra 
      * @return int 
      */
-    int diferenciaDias(const Fecha& otra) const {
+    constexpr int diferenciaDias(const Fecha& otra) const {
         if (this->dia > otra.dia) {
             return this->dia - otra.dia;
         } else {
@@ -102,6 +312,33 @@ class Fecha{
         }
     }
 
+    /**
+     * @brief Calcula los dias transcurridos entre el objeto actual y otro objeto Fecha, en tiempo constante.
+     * 
+     * @param otra 
+     * @return int 
+     */
+    constexpr int diasTranscurridos(const Fecha& otra) const {
+        int diferencia = otra.diaSerial() - diaSerial();
+        return diferencia < 0 ? -diferencia : diferencia;
+    }
+
+    /**
+     * @brief Calcula el tiempo transcurrido entre el objeto actual y otro objeto Fecha en años, meses y dias.
+     * 
+     * Un mes se cuenta cuando se alcanza el mismo dia del mes siguiente, o su ultimo dia si ese mes
+     * es mas corto (en 2024: 31/01 a 29/02 es 1 mes; 31/01 a 01/03 es 1 mes y 1 dia; 31/01 a 01/04
+     * son 2 meses y 1 dia).
+     * 
+     * @param otra 
+     * @return Duracion 
+     */
+    constexpr Duracion duracionCalendario(const Fecha& otra) const {
+        const Fecha& desde = diaSerial() <= otra.diaSerial() ? *this : otra;
+        const Fecha& hasta = diaSerial() <= otra.diaSerial() ? otra : *this;
+        return duracionEntre(desde, hasta.diaSerial(), hasta.dia);
+    }
+
     /**
      * @brief Compara si dos objetos fecha son iguales.
      * 
@@ -109,17 +346,42 @@ class Fecha{
      * @return true 
      * @return false 
      */
-    bool operator==(const Fecha& otra) const {
+    constexpr bool operator==(const Fecha& otra) const {
         return (dia == otra.dia && mes == otra.mes && anio == otra.anio);
     }
 
+    /**
+     * @brief Devuelve una clave entera cuyo orden coincide con el orden cronologico.
+     * 
+     * Mes y dia deben caber en sus 4 y 5 bits; si no, dos fechas distintas tendrian la misma
+     * clave y operator<=> contradiria a operator==.
+     * 
+     * @return uint64_t 
+     * @throw std::invalid_argument Si mes o dia no caben en la clave.
+     */
+    constexpr uint64_t claveOrden() const {
+        return (unsigned)mes < 16 && (unsigned)dia < 32
+                   ? ((uint64_t)((int64_t)anio + ((int64_t)1 << 31)) << 9) | ((uint64_t)mes << 5) | (uint64_t)dia
+                   : throw std::invalid_argument("Fecha fuera del rango de la clave de orden");
+    }
+
+    /**
+     * @brief Compara cronologicamente dos objetos Fecha.
+     * 
+     * @param otra 
+     * @return std::strong_ordering 
+     */
+    constexpr std::strong_ordering operator<=>(const Fecha& otra) const {
+        return claveOrden() <=> otra.claveOrden();
+    }
+
     /**
      * @brief Devuelve un nuevo objeto Fecha con años sumados al actual.
      * 
      * @param cantidad 
      * @return Fecha 
      */
-    Fecha sumarAnios(int cantidad) const {
+    constexpr Fecha sumarAnios(int cantidad) const {
         return Fecha(dia, mes, anio + cantidad);
     }
 
@@ -129,7 +391,7 @@ class Fecha{
      * @param cantidad 
      * @return Fecha 
      */
-    Fecha restarAnios(int cantidad) const {
+    constexpr Fecha restarAnios(int cantidad) const {
         return Fecha(dia, mes, anio - cantidad);
     }
 
@@ -138,19 +400,19 @@ class Fecha{
      * 
      * @return int 
      */
-    int getDia()  const  { return dia; }
+    constexpr int getDia()  const  { return dia; }
     /**
      * @brief Metodo para accdeder al atributo privado mes.
      * 
      * @return int 
      */
-    int getMes()  const  { return mes; }
+    constexpr int getMes()  const  { return mes; }
     /**
      * @brief Metodo para accdeder al atributo privado año.
      * 
      * @return int 
      */
-    int getAnio() const  { return anio; }
+    constexpr int getAnio() const  { return anio; }
 
     /**
      * @brief Devuelve el numero de dias de un mes especifico, considerando años bisiestos.
@@ -159,14 +421,58 @@ class Fecha{
      * @param a 
      * @return int 
      */
-    int diasEnMes(int m, int a) const {
-        if (m == 2) { // Febrero
-            return (a % 4 == 0 && (a % 100 != 0 || a % 400 == 0)) ? 29 : 28;
+    static constexpr int diasEnMes(int m, int a) {
+        return (unsigned)(m - 1) < 12 ? DIAS_POR_MES[esBisiesto(a)][m] : 31;
+    }
+
+    /**
+     * @brief Devuelve el dia del año (1 a 366).
+     * 
+     * @return int 0 si el mes esta fuera de 1 a 12.
+     */
+    constexpr int diaDelAnio() const {
+        return (unsigned)(mes - 1) < 12 ? DIAS_ACUMULADOS[esBisiesto(anio)][mes] + dia : 0;
+    }
+
+    /**
+     * @brief Devuelve el dia de la semana segun ISO-8601 (1 = lunes, 7 = domingo).
+     * 
+     * @return int 
+     */
+    constexpr int diaSemana() const {
+        int resto = (diaSerial() + 3) % 7;
+        return (resto < 0 ? resto + 7 : resto) + 1;
+    }
+
+    /**
+     * @brief Calcula años, meses y dias desde una fecha hasta un dia serial posterior, sin ciclos.
+     * 
+     * @param desde 
+     * @param serialHasta 
+     * @param diaHasta 
+     * @return Duracion 
+     */
+    static constexpr Duracion duracionEntre(const Fecha& desde, int serialHasta, int diaHasta) {
+        int d = 0, m = 0, a = 0;
+        civilDesdeSerial(serialHasta, d, m, a);
+        int meses = (a * 12 + m) - (desde.anio * 12 + desde.mes);
+        // Si el mes de llegada es mas corto que desde.dia, su ultimo dia ya completa el mes.
+        if (meses > 0 && diaHasta < desde.dia && diaHasta < desde.diasEnMes(m, a)) {
+            meses--;
         }
-        if (m == 4 || m == 6 || m == 9 || m == 11) {
-            return 30;
+        int mesIntermedio  = desde.mes - 1 + meses % 12;
+        int anioIntermedio = desde.anio + meses / 12 + mesIntermedio / 12;
+        mesIntermedio      = mesIntermedio % 12 + 1;
+        int diaIntermedio  = desde.dia;
+        int maximo = desde.diasEnMes(mesIntermedio, anioIntermedio);
+        if (diaIntermedio > maximo) {
+            diaIntermedio = maximo;
         }
-        return 31;
+        Duracion r;
+        r.anios = meses / 12;
+        r.meses = meses % 12;
+        r.dias  = serialHasta - serialDesdeCivil(diaIntermedio, mesIntermedio, anioIntermedio);
+        return r;
     }
 
     /**
@@ -175,11 +481,46 @@ class Fecha{
      * @return std::string 
      */
     std::string retornarFecha() const {
-        std::string fecha;
+        char buf[LARGO_MAX_FORMATO];
+        return std::string(buf, escribirFecha(buf));
+    }
 
-        fecha = std::to_string(dia) + "/" + std::to_string(mes) + "/" + std::to_string(anio);
+    /**
+     * @brief Escribe la fecha en formato DD/MM/YYYY en un buffer del llamador, sin asignar memoria.
+     * 
+     * @param destino Buffer de al menos LARGO_MAX_FORMATO bytes.
+     * @return char* Posicion siguiente al ultimo caracter escrito.
+     */
+    char* escribirFecha(char* destino) const {
+        destino = escribirDosDigitos(destino, dia);
+        *destino++ = '/';
+        destino = escribirDosDigitos(destino, mes);
+        *destino++ = '/';
+        return escribirAnio(destino, anio);
+    }
 
-        return fecha;
+    /**
+     * @brief Lee una fecha en formato DD/MM/YYYY.
+     * 
+     * @param p 
+     * @param fin 
+     * @param resultado 
+     * @return const char* Posicion siguiente a la fecha leida, o nullptr si no es valida.
+     */
+    static const char* leerFecha(const char* p, const char* fin, Fecha& resultado) {
+        if (fin - p < 10) {
+            return nullptr;
+        }
+        uint32_t malo = (uint32_t)(p[2] != '/') | (uint32_t)(p[5] != '/');
+        int d = (int)(leerDigito(p[0], malo) * 10 + leerDigito(p[1], malo));
+        int m = (int)(leerDigito(p[3], malo) * 10 + leerDigito(p[4], malo));
+        int a = (int)(leerDigito(p[6], malo) * 1000 + leerDigito(p[7], malo) * 100 +
+                      leerDigito(p[8], malo) * 10 + leerDigito(p[9], malo));
+        if (malo || !esFechaValida(d, m, a)) {
+            return nullptr;
+        }
+        resultado = Fecha(d, m, a);
+        return p + 10;
     }
 };
 
@@ -204,12 +545,27 @@ class FechaHora: public Fecha{
      * @param _minuto 
      * @param _segundo 
      */
-    FechaHora(int _dia, int _mes, int _anio,
-              int _hora, int _minuto, int _segundo)
-              : Fecha(_dia, _mes, _anio) {
-        hora    = _hora;
-        minuto  = _minuto;
-        segundo = _segundo;
+    constexpr FechaHora(int _dia, int _mes, int _anio,
+                        int _hora, int _minuto, int _segundo)
+              : Fecha(_dia, _mes, _anio), hora(_hora), minuto(_minuto), segundo(_segundo) {}
+
+    /**
+     * @brief Crea un FechaHora validado; un valor invalido en un contexto constexpr es un error de compilacion.
+     * 
+     * @param _dia 
+     * @param _mes 
+     * @param _anio 
+     * @param _hora 
+     * @param _minuto 
+     * @param _segundo 
+     * @return FechaHora 
+     */
+    static constexpr FechaHora crear(int _dia, int _mes, int _anio,
+                                     int _hora, int _minuto, int _segundo) {
+        return esFechaValida(_dia, _mes, _anio) && _hora >= 0 && _hora < 24 &&
+               _minuto >= 0 && _minuto < 60 && _segundo >= 0 && _segundo < 60
+                   ? FechaHora(_dia, _mes, _anio, _hora, _minuto, _segundo)
+                   : throw std::invalid_argument("FechaHora invalida");
     }
 
     /**
@@ -218,7 +574,7 @@ class FechaHora: public Fecha{
      * @param dias 
      * @return FechaHora 
      */
-    FechaHora sumarDias(int dias) const {
+    constexpr FechaHora sumarDias(int dias) const {
         FechaHora nuevaFecha = *this;
         nuevaFecha.Fecha::agregarDias(dias);
         return nuevaFecha;
@@ -230,52 +586,110 @@ class FechaHora: public Fecha{
      * @param dias 
      * @return FechaHora 
      */
-    FechaHora restarDias(int dias) const {
+    constexpr FechaHora restarDias(int dias) const {
         FechaHora resultado = *this;
         resultado.Fecha::restarDias(dias);
         return resultado;
     }
 
     /**
-     * @brief Suma horas, ajustando dias segun sea necesario.
+     * @brief Devuelve el numero de segundos desde el 01/01/1970 00:00:00 (puede ser negativo).
      * 
-     * @param horas 
-     * @return FechaHora 
+     * @return int64_t 
      */
-    FechaHora sumarHoras(int horas) const {
-        FechaHora nuevaFechaHora = *this;
-        nuevaFechaHora.hora += horas;
+    constexpr int64_t segundosEpoca() const {
+        return (int64_t)diaSerial() * 86400 + hora * 3600 + minuto * 60 + segundo;
+    }
 
-        while (nuevaFechaHora.hora >= 24) {
-            nuevaFechaHora.hora -= 24;
-            nuevaFechaHora.agregarDias(1);
+    /**
+     * @brief Crea un FechaHora a partir del numero de segundos desde el 01/01/1970 00:00:00.
+     * 
+     * @param segundos 
+     * @return FechaHora 
+     */
+    static constexpr FechaHora desdeSegundosEpoca(int64_t segundos) {
+        int64_t dias = segundos / 86400;
+        int64_t resto = segundos % 86400;
+        if (resto < 0) {
+            resto += 86400;
+            dias--;
         }
+        int d = 0, m = 0, a = 0;
+        civilDesdeSerial((int)dias, d, m, a);
+        return FechaHora(d, m, a, (int)(resto / 3600), (int)(resto % 3600 / 60), (int)(resto % 60));
+    }
 
-        return nuevaFechaHora;
+    /**
+     * @brief Devuelve la fecha y hora actual en UTC consultando el reloj del sistema.
+     * 
+     * Para marcar muchos eventos por segundo conviene RelojCache::ahora.
+     * 
+     * @return FechaHora 
+     */
+    static FechaHora ahora() {
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return desdeSegundosEpoca((int64_t)ts.tv_sec);
     }
 
     /**
-     * @brief resta horas, ajustando dias segun sea necesario.
+     * @brief Suma segundos en tiempo constante, ajustando la fecha segun sea necesario.
      * 
-     * @param horas 
+     * @param segundos 
      * @return FechaHora 
      */
-    FechaHora restarHoras(int horas) const {
-        FechaHora nuevaFechaHora = *this;
+    constexpr FechaHora sumarSegundos(int64_t segundos) const {
+        return desdeSegundosEpoca(segundosEpoca() + segundos);
+    }
 
-        int diasARestar = horas / 24;
-        int horasRestantes = horas % 24;
+    /**
+     * @brief Resta segundos en tiempo constante, ajustando la fecha segun sea necesario.
+     * 
+     * @param segundos 
+     * @return FechaHora 
+     */
+    constexpr FechaHora restarSegundos(int64_t segundos) const {
+        return desdeSegundosEpoca(segundosEpoca() - segundos);
+    }
 
-        nuevaFechaHora.Fecha::restarDias(diasARestar);
+    /**
+     * @brief Suma minutos en tiempo constante, ajustando la fecha segun sea necesario.
+     * 
+     * @param minutos 
+     * @return FechaHora 
+     */
+    constexpr FechaHora sumarMinutos(int64_t minutos) const {
+        return sumarSegundos(minutos * 60);
+    }
 
-        nuevaFechaHora.hora -= horasRestantes;
+    /**
+     * @brief Resta minutos en tiempo constante, ajustando la fecha segun sea necesario.
+     * 
+     * @param minutos 
+     * @return FechaHora 
+     */
+    constexpr FechaHora restarMinutos(int64_t minutos) const {
+        return restarSegundos(minutos * 60);
+    }
 
-        while (nuevaFechaHora.hora < 0) {
-            nuevaFechaHora.hora += 24;
-            nuevaFechaHora.Fecha::restarDias(1);
-        }
+    /**
+     * @brief Suma horas en tiempo constante, ajustando dias segun sea necesario.
+     * 
+     * @param horas 
+     * @return FechaHora 
+     */
+    constexpr FechaHora sumarHoras(int horas) const {
+        return sumarSegundos((int64_t)horas * 3600);
+    }
 
-        return nuevaFechaHora;
+    /**
+     * @brief Resta horas en tiempo constante, ajustando dias segun sea necesario.
+     * 
+     * @param horas 
+     * @return FechaHora 
+     */
+    constexpr FechaHora restarHoras(int horas) const {
+        return restarSegundos((int64_t)horas * 3600);
     }
 
     /**
@@ -284,7 +698,7 @@ class FechaHora: public Fecha{
      * @param otra 
      * @return int 
      */
-    int diferenciaHoras(const FechaHora& otra) const {
+    constexpr int diferenciaHoras(const FechaHora& otra) const {
         if (this->hora > otra.hora) {
             return this->hora - otra.hora;
         } else {
@@ -298,7 +712,7 @@ class FechaHora: public Fecha{
      * @param otra 
      * @return int 
      */
-    int diferenciaMinutos(const FechaHora& otra) const {
+    constexpr int diferenciaMinutos(const FechaHora& otra) const {
         if (this->minuto > otra.minuto) {
             return this->minuto - otra.minuto;
         } else {
@@ -312,7 +726,7 @@ class FechaHora: public Fecha{
      * @param otra 
      * @return int 
      */
-    int diferenciaSegundos(const FechaHora& otra) const {
+    constexpr int diferenciaSegundos(const FechaHora& otra) const {
         if (this->segundo > otra.segundo) {
             return this->segundo - otra.segundo;
         } else {
@@ -320,6 +734,48 @@ class FechaHora: public Fecha{
         }
     }
 
+    /**
+     * @brief Calcula los segundos transcurridos entre el objeto actual y otro objeto FechaHora, en tiempo constante.
+     * 
+     * @param otra 
+     * @return int64_t 
+     */
+    constexpr int64_t segundosTranscurridos(const FechaHora& otra) const {
+        int64_t diferencia = otra.segundosEpoca() - segundosEpoca();
+        return diferencia < 0 ? -diferencia : diferencia;
+    }
+
+    using Fecha::duracionCalendario;
+
+    /**
+     * @brief Calcula el tiempo transcurrido entre el objeto actual y otro objeto FechaHora,
+     *        en años, meses, dias, horas, minutos y segundos.
+     * 
+     * @param otra 
+     * @return Duracion 
+     */
+    constexpr Duracion duracionCalendario(const FechaHora& otra) const {
+        const FechaHora& desde = segundosEpoca() <= otra.segundosEpoca() ? *this : otra;
+        const FechaHora& hasta = segundosEpoca() <= otra.segundosEpoca() ? otra : *this;
+
+        int64_t tiempoDesde = desde.hora * 3600 + desde.minuto * 60 + desde.segundo;
+        int64_t tiempoHasta = hasta.hora * 3600 + hasta.minuto * 60 + hasta.segundo;
+        int serialHasta = hasta.diaSerial();
+        if (tiempoHasta < tiempoDesde) {
+            tiempoHasta += 86400;
+            serialHasta--;
+        }
+        int d = 0, m = 0, a = 0;
+        civilDesdeSerial(serialHasta, d, m, a);
+
+        Duracion r = duracionEntre(desde, serialHasta, d);
+        int64_t resto = tiempoHasta - tiempoDesde;
+        r.horas    = (int)(resto / 3600);
+        r.minutos  = (int)(resto % 3600 / 60);
+        r.segundos = (int)(resto % 60);
+        return r;
+    }
+
     /**
      * @brief Compara si dos objetos FechaHora son iguales.
      * 
@@ -327,9 +783,28 @@ class FechaHora: public Fecha{
      * @return true 
      * @return false 
      */
-    bool operator==(const FechaHora& otra) const {
+    constexpr bool operator==(const FechaHora& otra) const {
         return Fecha::operator==(otra) && hora == otra.hora && minuto == otra.minuto && segundo == otra.segundo;
     }
+
+    /**
+     * @brief Devuelve una clave entera cuyo orden coincide con el orden cronologico
+     *        (el valor de FechaHoraCompacta).
+     * 
+     * @return uint64_t 
+     * @throw std::invalid_argument Si algun campo no cabe en la clave.
+     */
+    constexpr uint64_t claveOrden() const;
+
+    /**
+     * @brief Compara cronologicamente dos objetos FechaHora.
+     * 
+     * @param otra 
+     * @return std::strong_ordering 
+     */
+    constexpr std::strong_ordering operator<=>(const FechaHora& otra) const {
+        return claveOrden() <=> otra.claveOrden();
+    }
     
     /**
      * @brief Devuelve un nuevo objeto con años sumados.
@@ -337,7 +812,7 @@ class FechaHora: public Fecha{
      * @param cantidad 
      * @return FechaHora 
      */
-    FechaHora sumarAnios(int cantidad) const {
+    constexpr FechaHora sumarAnios(int cantidad) const {
         Fecha nuevaFecha = Fecha::sumarAnios(cantidad);
         return FechaHora(nuevaFecha.getDia(), nuevaFecha.getMes(), nuevaFecha.getAnio(), hora, minuto, segundo);
     }
@@ -348,26 +823,1999 @@ class FechaHora: public Fecha{
      * @param cantidad 
      * @return FechaHora 
      */
-    FechaHora restarAnios(int cantidad) const {
+    constexpr FechaHora restarAnios(int cantidad) const {
         Fecha nuevaFecha = Fecha::restarAnios(cantidad);
         return FechaHora(nuevaFecha.getDia(), nuevaFecha.getMes(), nuevaFecha.getAnio(), hora, minuto, segundo);
     }
 
+    /**
+     * @brief Metodo para accdeder al atributo privado hora.
+     * 
+     * @return int 
+     */
+    constexpr int getHora()    const { return hora; }
+    /**
+     * @brief Metodo para accdeder al atributo privado minuto.
+     * 
+     * @return int 
+     */
+    constexpr int getMinuto()  const { return minuto; }
+    /**
+     * @brief Metodo para accdeder al atributo privado segundo.
+     * 
+     * @return int 
+     */
+    constexpr int getSegundo() const { return segundo; }
+
     /**
      * @brief Devuelve una representacion en cadena del tiempo en formato HH:MM:SS.
      * 
      * @return std::string 
      */
     std::string retornarTiempo() const {
-        std::string tiempo;
-
-        tiempo = std::to_string(hora) + ":" + std::to_string(minuto) + ":" + std::to_string(segundo);
+        char buf[LARGO_MAX_FORMATO];
+        return std::string(buf, escribirTiempo(buf));
+    }
 
-        return tiempo;
+    /**
+     * @brief Escribe el tiempo en formato HH:MM:SS en un buffer del llamador, sin asignar memoria.
+     * 
+     * @param destino Buffer de al menos LARGO_MAX_FORMATO bytes.
+     * @return char* Posicion siguiente al ultimo caracter escrito.
+     */
+    char* escribirTiempo(char* destino) const {
+        destino = escribirDosDigitos(destino, hora);
+        *destino++ = ':';
+        destino = escribirDosDigitos(destino, minuto);
+        *destino++ = ':';
+        return escribirDosDigitos(destino, segundo);
     }
-};
 
-/**
+    /**
+     * @brief Escribe la fecha y hora en formato ISO-8601 (YYYY-MM-DDTHH:MM:SS), sin asignar memoria.
+     * 
+     * @param destino Buffer de al menos LARGO_MAX_FORMATO bytes.
+     * @return char* Posicion siguiente al ultimo caracter escrito.
+     */
+    char* escribirISO8601(char* destino) const {
+        destino = escribirAnio(destino, getAnio());
+        *destino++ = '-';
+        destino = escribirDosDigitos(destino, getMes());
+        *destino++ = '-';
+        destino = escribirDosDigitos(destino, getDia());
+        *destino++ = 'T';
+        return escribirTiempo(destino);
+    }
+
+    /**
+     * @brief Lee una fecha y hora ISO-8601 (YYYY-MM-DDTHH:MM:SS, acepta ' ' en lugar de 'T' y una 'Z' final).
+     * 
+     * Todos los caracteres se validan sin ramas y se decide una sola vez al final.
+     * 
+     * @param p 
+     * @param fin 
+     * @param resultado 
+     * @return const char* Posicion siguiente a lo leido, o nullptr si no es valido.
+     */
+    static const char* leerISO8601(const char* p, const char* fin, FechaHora& resultado) {
+        if (fin - p < 19) {
+            return nullptr;
+        }
+        uint32_t malo = (uint32_t)(p[4] != '-') | (uint32_t)(p[7] != '-') |
+                        (uint32_t)(p[10] != 'T' && p[10] != ' ') |
+                        (uint32_t)(p[13] != ':') | (uint32_t)(p[16] != ':');
+        int a  = (int)(leerDigito(p[0], malo) * 1000 + leerDigito(p[1], malo) * 100 +
+                       leerDigito(p[2], malo) * 10 + leerDigito(p[3], malo));
+        int m  = (int)(leerDigito(p[5], malo) * 10 + leerDigito(p[6], malo));
+        int d  = (int)(leerDigito(p[8], malo) * 10 + leerDigito(p[9], malo));
+        int h  = (int)(leerDigito(p[11], malo) * 10 + leerDigito(p[12], malo));
+        int mi = (int)(leerDigito(p[14], malo) * 10 + leerDigito(p[15], malo));
+        int se = (int)(leerDigito(p[17], malo) * 10 + leerDigito(p[18], malo));
+        malo |= (uint32_t)(h > 23) | (uint32_t)(mi > 59) | (uint32_t)(se > 59);
+        if (malo || !esFechaValida(d, m, a)) {
+            return nullptr;
+        }
+        resultado = FechaHora(d, m, a, h, mi, se);
+        p += 19;
+        return (p < fin && *p == 'Z') ? p + 1 : p;
+    }
+};
+
+/**
+ * @brief Representacion de FechaHora en 8 bytes para almacenar grandes volumenes de marcas de tiempo.
+ * 
+ * Los campos se empaquetan en un uint64_t, del bit mas significativo al menos significativo:
+ * año + 2^31 (32 bits), mes (4), dia (5), hora (5), minuto (6), segundo (6).
+ * Por eso el orden natural del entero coincide con el orden cronologico.
+ * La conversion es sin perdida para cualquier FechaHora cuyos campos quepan en sus bits (en particular
+ * cualquiera valido); los demas se rechazan en vez de truncarse.
+ */
+class FechaHoraCompacta {
+    private:
+    uint64_t valor;
+
+    static constexpr int BITS_SEGUNDO = 0;
+    static constexpr int BITS_MINUTO  = 6;
+    static constexpr int BITS_HORA    = 12;
+    static constexpr int BITS_DIA     = 17;
+    static constexpr int BITS_MES     = 22;
+    static constexpr int BITS_ANIO    = 26;
+    static constexpr int64_t DESPLAZAMIENTO_ANIO = (int64_t)1 << 31;
+
+    constexpr int campo(int desde, int bits) const {
+        return (int)((valor >> desde) & ((1u << bits) - 1));
+    }
+
+    public:
+    /**
+     * @brief Constructor por defecto (00/00/-2147483648 00:00:00, el menor valor posible).
+     * 
+     */
+    constexpr FechaHoraCompacta() : valor(0) {}
+
+    /**
+     * @brief Constructor a partir de un FechaHora.
+     * 
+     * @param fh 
+     * @throw std::invalid_argument Si algun campo no cabe en sus bits; empaquetarlo perderia informacion.
+     */
+    constexpr explicit FechaHoraCompacta(const FechaHora& fh)
+        : valor((unsigned)fh.getMes() < 16 && (unsigned)fh.getDia() < 32 && (unsigned)fh.getHora() < 32 &&
+                (unsigned)fh.getMinuto() < 64 && (unsigned)fh.getSegundo() < 64
+                    ? ((uint64_t)((int64_t)fh.getAnio() + DESPLAZAMIENTO_ANIO) << BITS_ANIO) |
+                      ((uint64_t)fh.getMes()     << BITS_MES)    |
+                      ((uint64_t)fh.getDia()     << BITS_DIA)    |
+                      ((uint64_t)fh.getHora()    << BITS_HORA)   |
+                      ((uint64_t)fh.getMinuto()  << BITS_MINUTO) |
+                      ((uint64_t)fh.getSegundo() << BITS_SEGUNDO)
+                    : throw std::invalid_argument("FechaHora fuera del rango empaquetable")) {}
+
+    /**
+     * @brief Crea un objeto a partir del entero empaquetado.
+     * 
+     * @param _valor 
+     * @return FechaHoraCompacta 
+     */
+    static constexpr FechaHoraCompacta desdeValor(uint64_t _valor) {
+        FechaHoraCompacta c;
+        c.valor = _valor;
+        return c;
+    }
+
+    /**
+     * @brief Devuelve el entero empaquetado; su orden es el orden cronologico.
+     * 
+     * @return uint64_t 
+     */
+    constexpr uint64_t getValor() const { return valor; }
+
+    /**
+     * @brief Extrae el año del entero empaquetado.
+     * 
+     * @return int 
+     */
+    constexpr int getAnio()    const { return (int)((int64_t)(valor >> BITS_ANIO) - DESPLAZAMIENTO_ANIO); }
+    /**
+     * @brief Extrae el mes del entero empaquetado.
+     * 
+     * @return int 
+     */
+    constexpr int getMes()     const { return campo(BITS_MES, 4); }
+    /**
+     * @brief Extrae el dia del entero empaquetado.
+     * 
+     * @return int 
+     */
+    constexpr int getDia()     const { return campo(BITS_DIA, 5); }
+    /**
+     * @brief Extrae el hora del entero empaquetado.
+     * 
+     * @return int 
+     */
+    constexpr int getHora()    const { return campo(BITS_HORA, 5); }
+    /**
+     * @brief Extrae el minuto del entero empaquetado.
+     * 
+     * @return int 
+     */
+    constexpr int getMinuto()  const { return campo(BITS_MINUTO, 6); }
+    /**
+     * @brief Extrae el segundo del entero empaquetado.
+     * 
+     * @return int 
+     */
+    constexpr int getSegundo() const { return campo(BITS_SEGUNDO, 6); }
+
+    /**
+     * @brief Convierte de vuelta a FechaHora.
+     * 
+     * @return FechaHora 
+     */
+    constexpr FechaHora aFechaHora() const {
+        return FechaHora(getDia(), getMes(), getAnio(), getHora(), getMinuto(), getSegundo());
+    }
+
+    /**
+     * @brief Compara si dos objetos FechaHoraCompacta son iguales.
+     * 
+     * @param otra 
+     * @return true 
+     * @return false 
+     */
+    constexpr bool operator==(const FechaHoraCompacta& otra) const { return valor == otra.valor; }
+
+    /**
+     * @brief Indica si el objeto actual es anterior a otro.
+     * 
+     * @param otra 
+     * @return true 
+     * @return false 
+     */
+    constexpr bool operator<(const FechaHoraCompacta& otra) const { return valor < otra.valor; }
+};
+
+static_assert(sizeof(FechaHoraCompacta) == 8, "FechaHoraCompacta debe ocupar 8 bytes");
+
+constexpr uint64_t FechaHora::claveOrden() const {
+    return FechaHoraCompacta(*this).getValor();
+}
+
+/**
+ * @brief Ordena claves de 64 bits con radix sort LSD de 8 bits por pasada.
+ * 
+ * Los histogramas de las 8 pasadas se calculan en un solo recorrido, y se
+ * omiten las pasadas donde todas las claves comparten el mismo byte (por
+ * ejemplo los bytes altos del año).
+ * 
+ * @param claves 
+ */
+inline void ordenarClavesRadix(std::vector<uint64_t>& claves) {
+    const size_t n = claves.size();
+    if (n < 2) {
+        return;
+    }
+    std::vector<size_t> conteo(8 * 256, 0);
+    for (uint64_t c : claves) {
+        for (int b = 0; b < 8; b++) {
+            conteo[b * 256 + ((c >> (8 * b)) & 0xFF)]++;
+        }
+    }
+    std::vector<uint64_t> auxiliar(n);
+    uint64_t* origen  = claves.data();
+    uint64_t* destino = auxiliar.data();
+    for (int b = 0; b < 8; b++) {
+        size_t* cubetas = &conteo[b * 256];
+        if (cubetas[(origen[0] >> (8 * b)) & 0xFF] == n) {
+            continue;
+        }
+        size_t suma = 0;
+        for (int i = 0; i < 256; i++) {
+            size_t c = cubetas[i];
+            cubetas[i] = suma;
+            suma += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint64_t c = origen[i];
+            destino[cubetas[(c >> (8 * b)) & 0xFF]++] = c;
+        }
+        std::swap(origen, destino);
+    }
+    if (origen != claves.data()) {
+        std::copy(origen, origen + n, claves.data());
+    }
+}
+
+/**
+ * @brief Ordena cronologicamente un vector de FechaHora usando su clave de orden.
+ * 
+ * Como la clave es una representacion sin perdida, se ordenan solo las
+ * claves y luego se reconstruyen los objetos.
+ * 
+ * @param fechas 
+ */
+inline void ordenarRadix(std::vector<FechaHora>& fechas) {
+    std::vector<uint64_t> claves(fechas.size());
+    for (size_t i = 0; i < fechas.size(); i++) {
+        claves[i] = fechas[i].claveOrden();
+    }
+    ordenarClavesRadix(claves);
+    for (size_t i = 0; i < fechas.size(); i++) {
+        fechas[i] = FechaHoraCompacta::desdeValor(claves[i]).aFechaHora();
+    }
+}
+
+/**
+ * @brief Compara el tiempo de std::sort con comparador por campos contra ordenarRadix.
+ * 
+ * @param n 
+ */
+void compararOrdenamiento(size_t n) {
+    std::mt19937_64 generador(42);
+    std::vector<FechaHora> datos;
+    datos.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        datos.push_back(FechaHora::desdeSegundosEpoca((int64_t)(generador() % 4102444800ULL)));
+    }
+    std::vector<FechaHora> copia = datos;
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::sort(copia.begin(), copia.end(), [](const FechaHora& x, const FechaHora& y) {
+        if (x.getAnio()   != y.getAnio())   return x.getAnio()   < y.getAnio();
+        if (x.getMes()    != y.getMes())    return x.getMes()    < y.getMes();
+        if (x.getDia()    != y.getDia())    return x.getDia()    < y.getDia();
+        if (x.getHora()   != y.getHora())   return x.getHora()   < y.getHora();
+        if (x.getMinuto() != y.getMinuto()) return x.getMinuto() < y.getMinuto();
+        return x.getSegundo() < y.getSegundo();
+    });
+    double tiempoSort = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    inicio = std::chrono::steady_clock::now();
+    ordenarRadix(datos);
+    double tiempoRadix = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::cout << "Elementos: " << n << "\n";
+    std::cout << "std::sort por campos: " << tiempoSort << " s\n";
+    std::cout << "ordenarRadix: " << tiempoRadix << " s\n";
+    std::cout << "Resultados iguales: " << (datos == copia ? "si" : "no") << "\n";
+}
+
+/**
+ * @brief Constantes del algoritmo de Neri y Schneider para conversiones civiles sin ramas
+ *        (solo sumas, multiplicaciones y divisiones por constantes en 32 bits sin signo).
+ * 
+ * El rango valido es de los años -32000 a 2000000; dentro de ese rango el
+ * resultado es identico al de Fecha::serialDesdeCivil y Fecha::civilDesdeSerial.
+ */
+constexpr uint32_t LOTE_S = 82;
+constexpr uint32_t LOTE_K = 719468 + 146097 * LOTE_S;
+constexpr uint32_t LOTE_L = 400 * LOTE_S;
+
+/**
+ * @brief Convierte dia, mes y año a dias desde el 01/01/1970 sin ramas.
+ * 
+ * @param d 
+ * @param m 
+ * @param a 
+ * @return int32_t 
+ */
+constexpr int32_t serialDesdeCivilLote(int32_t d, int32_t m, int32_t a) {
+    const uint32_t j      = (uint32_t)m <= 2;
+    const uint32_t y      = (uint32_t)a + LOTE_L - j;
+    const uint32_t mm     = (uint32_t)m + 12 * j;
+    const uint32_t c      = y / 100;
+    const uint32_t yEstr  = 1461 * y / 4 - c + c / 4;
+    const uint32_t mEstr  = (979 * mm - 2919) / 32;
+    return (int32_t)(yEstr + mEstr + (uint32_t)d - 1 - LOTE_K);
+}
+
+/**
+ * @brief Convierte dias desde el 01/01/1970 a dia, mes y año sin ramas.
+ * 
+ * @param serial 
+ * @param d 
+ * @param m 
+ * @param a 
+ */
+constexpr void civilDesdeSerialLote(int32_t serial, int32_t& d, int32_t& m, int32_t& a) {
+    const uint32_t n1 = 4 * ((uint32_t)serial + LOTE_K) + 3;
+    const uint32_t c  = n1 / 146097;
+    const uint32_t n2 = (n1 % 146097) | 3;
+    const uint64_t p2 = (uint64_t)2939745 * n2;
+    const uint32_t z  = (uint32_t)(p2 >> 32);
+    const uint32_t ny = (uint32_t)p2 / 2939745 / 4;
+    const uint32_t n3 = 2141 * ny + 197913;
+    const uint32_t j  = ny >= 306;
+    a = (int32_t)(100 * c + z - LOTE_L + j);
+    m = (int32_t)((n3 >> 16) - 12 * j);
+    d = (int32_t)((n3 & 0xFFFF) / 2141 + 1);
+}
+
+/**
+ * @brief Lote de fechas en columnas (estructura de arreglos) para procesar millones de fechas.
+ * 
+ * Los ciclos sobre columnas no tienen ramas ni dependencias entre
+ * elementos, de modo que el compilador los vectoriza (SSE/AVX) con -O3.
+ * Cada fila produce el mismo resultado que el metodo escalar de Fecha o
+ * FechaHora correspondiente.
+ */
+class LoteFechas {
+    private:
+    std::vector<int32_t> dia;
+    std::vector<int32_t> mes;
+    std::vector<int32_t> anio;
+    std::vector<int32_t> serial;
+    std::vector<int32_t> segundoDelDia;
+
+    public:
+    /**
+     * @brief Agrega una fecha al lote (hora 00:00:00).
+     * 
+     * @param f 
+     */
+    void agregar(const Fecha& f) {
+        agregar(FechaHora(f.getDia(), f.getMes(), f.getAnio(), 0, 0, 0));
+    }
+
+    /**
+     * @brief Agrega una fecha y hora al lote.
+     * 
+     * @param fh 
+     */
+    void agregar(const FechaHora& fh) {
+        dia.push_back(fh.getDia());
+        mes.push_back(fh.getMes());
+        anio.push_back(fh.getAnio());
+        serial.push_back(0);
+        segundoDelDia.push_back(fh.getHora() * 3600 + fh.getMinuto() * 60 + fh.getSegundo());
+    }
+
+    /**
+     * @brief Devuelve la cantidad de filas del lote.
+     * 
+     * @return size_t 
+     */
+    size_t tamanio() const { return dia.size(); }
+
+    /**
+     * @brief Devuelve la fila i como Fecha (usa las columnas dia, mes y año).
+     * 
+     * @param i 
+     * @return Fecha 
+     */
+    Fecha fecha(size_t i) const { return Fecha(dia[i], mes[i], anio[i]); }
+
+    /**
+     * @brief Devuelve la fila i como FechaHora.
+     * 
+     * @param i 
+     * @return FechaHora 
+     */
+    FechaHora fechaHora(size_t i) const {
+        int s = segundoDelDia[i];
+        return FechaHora(dia[i], mes[i], anio[i], s / 3600, s % 3600 / 60, s % 60);
+    }
+
+    /**
+     * @brief Calcula la columna de dias seriales a partir de dia, mes y año.
+     * 
+     */
+    void calcularSeriales() {
+        const size_t n = tamanio();
+        const int32_t* __restrict d = dia.data();
+        const int32_t* __restrict m = mes.data();
+        const int32_t* __restrict a = anio.data();
+        int32_t* __restrict s = serial.data();
+        for (size_t i = 0; i < n; i++) {
+            s[i] = serialDesdeCivilLote(d[i], m[i], a[i]);
+        }
+    }
+
+    /**
+     * @brief Calcula dia, mes y año a partir de la columna de dias seriales.
+     * 
+     */
+    void calcularCiviles() {
+        const size_t n = tamanio();
+        int32_t* __restrict d = dia.data();
+        int32_t* __restrict m = mes.data();
+        int32_t* __restrict a = anio.data();
+        const int32_t* __restrict s = serial.data();
+        for (size_t i = 0; i < n; i++) {
+            int32_t dd = 0, mm = 0, aa = 0;
+            civilDesdeSerialLote(s[i], dd, mm, aa);
+            d[i] = dd;
+            m[i] = mm;
+            a[i] = aa;
+        }
+    }
+
+    /**
+     * @brief Suma dias a todas las filas; equivale a Fecha::agregarDias por fila.
+     * 
+     * @param dias 
+     */
+    void agregarDias(int32_t dias) {
+        calcularSeriales();
+        const size_t n = tamanio();
+        int32_t* __restrict s = serial.data();
+        for (size_t i = 0; i < n; i++) {
+            s[i] += dias;
+        }
+        calcularCiviles();
+    }
+
+    /**
+     * @brief Suma horas a todas las filas; equivale a FechaHora::sumarHoras por fila.
+     * 
+     * @param horas 
+     */
+    void sumarHoras(int32_t horas) {
+        int32_t dias  = horas / 24;
+        int32_t resto = horas % 24 * 3600;
+        calcularSeriales();
+        const size_t n = tamanio();
+        int32_t* __restrict s  = serial.data();
+        int32_t* __restrict sd = segundoDelDia.data();
+        for (size_t i = 0; i < n; i++) {
+            int32_t t       = sd[i] + resto;
+            int32_t acarreo = (t >= 86400) - (t < 0);
+            sd[i] = t - acarreo * 86400;
+            s[i] += dias + acarreo;
+        }
+        calcularCiviles();
+    }
+};
+
+/**
+ * @brief Mide LoteFechas contra los metodos escalares y verifica que los resultados sean iguales.
+ * 
+ * @param n 
+ */
+void compararLote(size_t n) {
+    std::mt19937_64 generador(7);
+    std::vector<FechaHora> datos;
+    LoteFechas lote;
+    datos.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        datos.push_back(FechaHora::desdeSegundosEpoca((int64_t)(generador() % 4102444800ULL)));
+        lote.agregar(datos.back());
+    }
+    const int32_t dias  = 12345;
+    const int32_t horas = -1000;
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<FechaHora> escalar = datos;
+    for (FechaHora& fh : escalar) {
+        fh = fh.sumarDias(dias).sumarHoras(horas);
+    }
+    double tiempoEscalar = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    inicio = std::chrono::steady_clock::now();
+    lote.agregarDias(dias);
+    lote.sumarHoras(horas);
+    double tiempoLote = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    size_t distintos = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (!(lote.fechaHora(i) == escalar[i])) {
+            distintos++;
+        }
+    }
+    std::cout << "Elementos: " << n << "\n";
+    std::cout << "Metodos escalares: " << tiempoEscalar << " s\n";
+    std::cout << "LoteFechas: " << tiempoLote << " s\n";
+    std::cout << "Filas distintas: " << distintos << "\n";
+}
+
+/**
+ * @brief Zona horaria con su tabla de transiciones, leida una sola vez desde los archivos TZif del sistema.
+ * 
+ * La tabla incluye las transiciones del archivo y, desde la ultima, las que
+ * genera la regla POSIX del pie del archivo hasta el año 2100. Convertir entre
+ * UTC y hora local es una busqueda binaria, y cada hilo recuerda la ultima
+ * ventana entre transiciones, por lo que marcas cercanas se resuelven sin buscar.
+ */
+class ZonaHoraria {
+    private:
+    std::string          nombre;
+    std::vector<int64_t> transiciones;   // Instantes UTC, en segundos desde la epoca, ordenados.
+    std::vector<int32_t> desfases;       // Desfase UTC vigente desde cada transicion.
+    int32_t              desfaseInicial; // Desfase antes de la primera transicion.
+    uint64_t             id;
+
+    static constexpr int ANIO_MAXIMO_REGLA = 2100;
+
+    /**
+     * @brief Ventana entre dos transiciones recordada por cada hilo.
+     * 
+     */
+    struct VentanaCache {
+        uint64_t id      = 0;
+        int64_t  desde   = 0;
+        int64_t  hasta   = 0;
+        int32_t  desfase = 0;
+    };
+
+    ZonaHoraria(std::string _nombre, int32_t _desfaseInicial)
+        : nombre(_nombre), desfaseInicial(_desfaseInicial), id(siguienteId()) {}
+
+    static uint64_t siguienteId() {
+        static std::atomic<uint64_t> contador(1);
+        return contador.fetch_add(1);
+    }
+
+    static int64_t leerEnteroBE(const unsigned char* p, int bytes) {
+        uint64_t v = 0;
+        for (int i = 0; i < bytes; i++) {
+            v = (v << 8) | p[i];
+        }
+        if (bytes == 4) {
+            return (int32_t)(uint32_t)v;
+        }
+        return (int64_t)v;
+    }
+
+    // Lectura de la regla POSIX TZ ("<-04>4<-03>,M9.1.6/24,M4.1.6/24").
+    static bool leerNombrePosix(const char*& p) {
+        if (*p == '<') {
+            while (*p && *p != '>') p++;
+            if (*p != '>') return false;
+            p++;
+            return true;
+        }
+        const char* inicio = p;
+        while ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z')) p++;
+        return p - inicio >= 3;
+    }
+
+    static bool leerHoraPosix(const char*& p, int32_t& segundos) {
+        int signo = 1;
+        if (*p == '+' || *p == '-') {
+            signo = *p == '-' ? -1 : 1;
+            p++;
+        }
+        if (*p < '0' || *p > '9') return false;
+        int32_t partes[3] = { 0, 0, 0 };
+        for (int i = 0; i < 3; i++) {
+            while (*p >= '0' && *p <= '9') {
+                partes[i] = partes[i] * 10 + (*p - '0');
+                p++;
+            }
+            if (i < 2 && *p == ':') {
+                p++;
+            } else {
+                break;
+            }
+        }
+        segundos = signo * (partes[0] * 3600 + partes[1] * 60 + partes[2]);
+        return true;
+    }
+
+    struct ReglaPosix {
+        char    tipo   = 'M';  // 'M' (Mm.s.d), 'J' (Jn, sin 29/02) o 'N' (n, desde 0)
+        int     mes    = 0;
+        int     semana = 0;
+        int     dia    = 0;
+        int32_t hora   = 7200;
+    };
+
+    static bool leerReglaPosix(const char*& p, ReglaPosix& r) {
+        auto numero = [&p]() {
+            int v = 0;
+            while (*p >= '0' && *p <= '9') {
+                v = v * 10 + (*p - '0');
+                p++;
+            }
+            return v;
+        };
+        if (*p == 'M') {
+            p++;
+            r.tipo = 'M';
+            r.mes = numero();
+            if (*p++ != '.') return false;
+            r.semana = numero();
+            if (*p++ != '.') return false;
+            r.dia = numero();
+        } else if (*p == 'J') {
+            p++;
+            r.tipo = 'J';
+            r.dia = numero();
+        } else if (*p >= '0' && *p <= '9') {
+            r.tipo = 'N';
+            r.dia = numero();
+        } else {
+            return false;
+        }
+        if (*p == '/') {
+            p++;
+            return leerHoraPosix(p, r.hora);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Segundos locales (desde la epoca) en que se aplica una regla en un año.
+     * 
+     */
+    static int64_t instanteRegla(const ReglaPosix& r, int anio) {
+        int serial;
+        if (r.tipo == 'M') {
+            int primero = Fecha::serialDesdeCivil(1, r.mes, anio);
+            int diaSemana = ((primero + 4) % 7 + 7) % 7;    // 0 = domingo
+            int dia = 1 + (r.dia - diaSemana + 7) % 7 + (r.semana - 1) * 7;
+            while (dia > Fecha::diasEnMes(r.mes, anio)) {
+                dia -= 7;
+            }
+            serial = primero + dia - 1;
+        } else if (r.tipo == 'J') {
+            serial = Fecha::serialDesdeCivil(1, 1, anio) + r.dia - 1 +
+                     (Fecha::esBisiesto(anio) && r.dia >= 60 ? 1 : 0);
+        } else {
+            serial = Fecha::serialDesdeCivil(1, 1, anio) + r.dia;
+        }
+        return (int64_t)serial * 86400 + r.hora;
+    }
+
+    /**
+     * @brief Agrega las transiciones generadas por la regla POSIX posteriores a la ultima del archivo.
+     * 
+     */
+    void expandirReglaPosix(const std::string& regla) {
+        const char* p = regla.c_str();
+        int32_t posixEstandar = 0;
+        if (!leerNombrePosix(p) || !leerHoraPosix(p, posixEstandar)) {
+            return;
+        }
+        int32_t estandar = -posixEstandar;
+        if (*p == '\0') {
+            if (transiciones.empty()) {
+                desfaseInicial = estandar;
+            }
+            return;
+        }
+        if (!leerNombrePosix(p)) {
+            return;
+        }
+        int32_t verano = estandar + 3600;
+        if (*p != ',' && *p != '\0') {
+            int32_t posixVerano = 0;
+            if (!leerHoraPosix(p, posixVerano)) return;
+            verano = -posixVerano;
+        }
+        ReglaPosix inicio, fin;
+        if (*p++ != ',' || !leerReglaPosix(p, inicio) || *p++ != ',' || !leerReglaPosix(p, fin)) {
+            return;
+        }
+        int64_t ultima = transiciones.empty() ? INT64_MIN : transiciones.back();
+        int anioInicial = 1970;
+        if (!transiciones.empty()) {
+            anioInicial = FechaHora::desdeSegundosEpoca(ultima).getAnio();
+        }
+        for (int anio = anioInicial; anio <= ANIO_MAXIMO_REGLA; anio++) {
+            int64_t utcInicio = instanteRegla(inicio, anio) - estandar;
+            int64_t utcFin    = instanteRegla(fin, anio) - verano;
+            int64_t primero   = std::min(utcInicio, utcFin);
+            int64_t segundo   = std::max(utcInicio, utcFin);
+            int32_t desfasePrimero = primero == utcInicio ? verano : estandar;
+            int32_t desfaseSegundo = primero == utcInicio ? estandar : verano;
+            if (primero > ultima) {
+                transiciones.push_back(primero);
+                desfases.push_back(desfasePrimero);
+            }
+            if (segundo > ultima) {
+                transiciones.push_back(segundo);
+                desfases.push_back(desfaseSegundo);
+            }
+        }
+    }
+
+    /**
+     * @brief Lee un archivo TZif (version 1, 2 o 3).
+     * 
+     */
+    static std::unique_ptr<ZonaHoraria> leerTZif(const std::string& nombre, const std::string& ruta) {
+        int fd = open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Zona horaria no encontrada: " + nombre);
+        }
+        std::string datos;
+        char buf[16384];
+        ssize_t n;
+        while ((n = read(fd, buf, sizeof(buf))) > 0) {
+            datos.append(buf, (size_t)n);
+        }
+        close(fd);
+
+        const unsigned char* p   = (const unsigned char*)datos.data();
+        const unsigned char* fin = p + datos.size();
+        auto invalido = [&nombre]() {
+            return std::runtime_error("Archivo TZif invalido: " + nombre);
+        };
+        if (datos.size() < 44 || std::memcmp(p, "TZif", 4) != 0) {
+            throw invalido();
+        }
+        char version = (char)p[4];
+        int bytesTiempo = 4;
+        for (int pasada = 0; pasada < 2; pasada++) {
+            if (fin - p < 44 || std::memcmp(p, "TZif", 4) != 0) {
+                throw invalido();
+            }
+            int64_t isutcnt  = leerEnteroBE(p + 20, 4);
+            int64_t isstdcnt = leerEnteroBE(p + 24, 4);
+            int64_t leapcnt  = leerEnteroBE(p + 28, 4);
+            int64_t timecnt  = leerEnteroBE(p + 32, 4);
+            int64_t typecnt  = leerEnteroBE(p + 36, 4);
+            int64_t charcnt  = leerEnteroBE(p + 40, 4);
+            p += 44;
+            int64_t largo = timecnt * bytesTiempo + timecnt + typecnt * 6 + charcnt +
+                            leapcnt * (bytesTiempo + 4) + isstdcnt + isutcnt;
+            if (typecnt <= 0 || fin - p < largo) {
+                throw invalido();
+            }
+            if (version >= '2' && pasada == 0) {
+                p += largo;
+                bytesTiempo = 8;
+                continue;
+            }
+            const unsigned char* tiempos = p;
+            const unsigned char* indices = tiempos + timecnt * bytesTiempo;
+            const unsigned char* tipos   = indices + timecnt;
+            auto desfaseTipo = [&](int64_t t) -> int32_t {
+                return (int32_t)leerEnteroBE(tipos + (t < typecnt ? t : 0) * 6, 4);
+            };
+            std::unique_ptr<ZonaHoraria> zona(new ZonaHoraria(nombre, desfaseTipo(0)));
+            for (int64_t i = 0; i < timecnt; i++) {
+                zona->transiciones.push_back(leerEnteroBE(tiempos + i * bytesTiempo, bytesTiempo));
+                zona->desfases.push_back(desfaseTipo(indices[i]));
+            }
+            p += largo;
+            if (bytesTiempo == 8 && fin - p > 1 && *p == '\n') {
+                const unsigned char* finRegla = (const unsigned char*)std::memchr(p + 1, '\n', (size_t)(fin - p - 1));
+                if (finRegla != nullptr) {
+                    zona->expandirReglaPosix(std::string((const char*)p + 1, (const char*)finRegla));
+                }
+            }
+            return zona;
+        }
+        throw invalido();
+    }
+
+    public:
+    /**
+     * @brief Devuelve la zona IANA indicada (por ejemplo "America/Santiago"), leyendola solo la primera vez.
+     * 
+     * Usa el directorio de la variable TZDIR o /usr/share/zoneinfo.
+     * 
+     * @param nombre 
+     * @return const ZonaHoraria& 
+     * @throw std::runtime_error Si la zona no existe o el archivo es invalido.
+     */
+    static const ZonaHoraria& cargar(const std::string& nombre) {
+        static std::mutex mutexZonas;
+        static std::unordered_map<std::string, std::unique_ptr<ZonaHoraria>> zonas;
+
+        std::lock_guard<std::mutex> lock(mutexZonas);
+        auto it = zonas.find(nombre);
+        if (it != zonas.end()) {
+            return *it->second;
+        }
+        if (nombre.empty() || nombre[0] == '/' || nombre.find("..") != std::string::npos) {
+            throw std::runtime_error("Nombre de zona horaria invalido: " + nombre);
+        }
+        const char* directorio = std::getenv("TZDIR");
+        std::string ruta = std::string(directorio ? directorio : "/usr/share/zoneinfo") + "/" + nombre;
+        std::unique_ptr<ZonaHoraria> zona = leerTZif(nombre, ruta);
+        const ZonaHoraria& resultado = *zona;
+        zonas[nombre] = std::move(zona);
+        return resultado;
+    }
+
+    /**
+     * @brief Crea una zona con un desfase UTC fijo.
+     * 
+     * @param desfaseSegundos Por ejemplo -4 * 3600 para UTC-04:00.
+     * @return ZonaHoraria 
+     */
+    static ZonaHoraria fija(int32_t desfaseSegundos) {
+        char buf[LARGO_MAX_FORMATO];
+        int32_t absoluto = desfaseSegundos < 0 ? -desfaseSegundos : desfaseSegundos;
+        char* p = buf;
+        *p++ = desfaseSegundos < 0 ? '-' : '+';
+        p = escribirDosDigitos(p, absoluto / 3600);
+        *p++ = ':';
+        p = escribirDosDigitos(p, absoluto % 3600 / 60);
+        return ZonaHoraria("UTC" + std::string(buf, p), desfaseSegundos);
+    }
+
+    /**
+     * @brief Devuelve el nombre de la zona.
+     * 
+     * @return const std::string& 
+     */
+    const std::string& getNombre() const { return nombre; }
+
+    /**
+     * @brief Devuelve el desfase UTC (segundos) vigente en un instante UTC.
+     * 
+     * @param segundosUTC 
+     * @return int32_t 
+     */
+    int32_t desfaseEn(int64_t segundosUTC) const {
+        thread_local VentanaCache cache;
+        if (cache.id == id && segundosUTC >= cache.desde && segundosUTC < cache.hasta) {
+            return cache.desfase;
+        }
+        size_t i = (size_t)(std::upper_bound(transiciones.begin(), transiciones.end(), segundosUTC) -
+                            transiciones.begin());
+        cache.id      = id;
+        cache.desde   = i == 0 ? INT64_MIN : transiciones[i - 1];
+        cache.hasta   = i == transiciones.size() ? INT64_MAX : transiciones[i];
+        cache.desfase = i == 0 ? desfaseInicial : desfases[i - 1];
+        return cache.desfase;
+    }
+
+    /**
+     * @brief Convierte un FechaHora en UTC a la hora local de la zona.
+     * 
+     * @param utc 
+     * @return FechaHora 
+     */
+    FechaHora aLocal(const FechaHora& utc) const {
+        int64_t s = utc.segundosEpoca();
+        return FechaHora::desdeSegundosEpoca(s + desfaseEn(s));
+    }
+
+    /**
+     * @brief Convierte una hora local de la zona a UTC.
+     * 
+     * Si la hora local se repite (fin del horario de verano) se usa la primera
+     * ocurrencia; si no existe (inicio del horario de verano) se avanza segun el salto.
+     * 
+     * @param local 
+     * @return FechaHora 
+     */
+    FechaHora aUTC(const FechaHora& local) const {
+        int64_t s = local.segundosEpoca();
+        int32_t antes   = desfaseEn(s - 86400);
+        int32_t despues = desfaseEn(s + 86400);
+        if (desfaseEn(s - antes) == antes) {
+            return FechaHora::desdeSegundosEpoca(s - antes);
+        }
+        if (desfaseEn(s - despues) == despues) {
+            return FechaHora::desdeSegundosEpoca(s - despues);
+        }
+        return FechaHora::desdeSegundosEpoca(s - antes);
+    }
+};
+
+/**
+ * @brief Resultado de procesar un registro con una marca de tiempo ISO-8601 al inicio de cada linea.
+ * 
+ */
+struct ResumenMarcas {
+    size_t   lineas    = 0;
+    size_t   validas   = 0;
+    uint64_t minimo    = UINT64_MAX;
+    uint64_t maximo    = 0;
+};
+
+/**
+ * @brief Procesa un bloque de memoria con una marca de tiempo ISO-8601 al inicio de cada linea.
+ * 
+ * @param datos 
+ * @param largo 
+ * @return ResumenMarcas 
+ */
+inline ResumenMarcas procesarMarcas(const char* datos, size_t largo) {
+    ResumenMarcas r;
+    const char* p   = datos;
+    const char* fin = datos + largo;
+    FechaHora fh(1, 1, 1970, 0, 0, 0);
+    while (p < fin) {
+        const char* finLinea = (const char*)std::memchr(p, '\n', (size_t)(fin - p));
+        if (finLinea == nullptr) {
+            finLinea = fin;
+        }
+        r.lineas++;
+        if (FechaHora::leerISO8601(p, finLinea, fh) != nullptr) {
+            uint64_t clave = fh.claveOrden();
+            r.validas++;
+            r.minimo = std::min(r.minimo, clave);
+            r.maximo = std::max(r.maximo, clave);
+        }
+        p = finLinea + 1;
+    }
+    return r;
+}
+
+/**
+ * @brief Procesa un archivo de registro mapeado en memoria e informa el rendimiento.
+ * 
+ * @param ruta 
+ * @return true 
+ * @return false Si el archivo no se pudo abrir o mapear.
+ */
+bool procesarArchivoMarcas(const std::string& ruta) {
+    int fd = open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cout << "No se pudo abrir " << ruta << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        close(fd);
+        std::cout << "Archivo vacio o ilegible: " << ruta << "\n";
+        return false;
+    }
+    size_t largo = (size_t)st.st_size;
+    void* mapa = mmap(nullptr, largo, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        std::cout << "No se pudo mapear " << ruta << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    madvise(mapa, largo, MADV_SEQUENTIAL);
+
+    auto inicio = std::chrono::steady_clock::now();
+    ResumenMarcas r = procesarMarcas((const char*)mapa, largo);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    munmap(mapa, largo);
+
+    std::cout << "Lineas: " << r.lineas << ", marcas validas: " << r.validas << "\n";
+    if (r.validas > 0) {
+        char buf[LARGO_MAX_FORMATO];
+        FechaHora minimo = FechaHoraCompacta::desdeValor(r.minimo).aFechaHora();
+        FechaHora maximo = FechaHoraCompacta::desdeValor(r.maximo).aFechaHora();
+        std::cout << "Primera: " << std::string(buf, minimo.escribirISO8601(buf)) << "\n";
+        std::cout << "Ultima: " << std::string(buf, maximo.escribirISO8601(buf)) << "\n";
+    }
+    std::cout << "Rendimiento: " << (double)largo / segundos / 1e6 << " MB/s\n";
+    return true;
+}
+
+/**
+ * @brief Mide el formateo y la lectura ISO-8601 sobre un registro generado en memoria.
+ * 
+ * @param n 
+ */
+void compararParseo(size_t n) {
+    static const char mensaje[] = " INFO solicitud atendida\n";
+    std::mt19937_64 generador(11);
+    std::vector<FechaHora> datos;
+    datos.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        datos.push_back(FechaHora::desdeSegundosEpoca((int64_t)(generador() % 4102444800ULL)));
+    }
+    std::vector<char> registro(n * (LARGO_MAX_FORMATO + sizeof(mensaje)));
+
+    auto inicio = std::chrono::steady_clock::now();
+    char* p = registro.data();
+    for (const FechaHora& fh : datos) {
+        p = fh.escribirISO8601(p);
+        std::memcpy(p, mensaje, sizeof(mensaje) - 1);
+        p += sizeof(mensaje) - 1;
+    }
+    double tiempoFormato = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    size_t largo = (size_t)(p - registro.data());
+
+    inicio = std::chrono::steady_clock::now();
+    ResumenMarcas r = procesarMarcas(registro.data(), largo);
+    double tiempoLectura = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::cout << "Marcas: " << n << " (" << largo / 1e6 << " MB), validas: " << r.validas << "\n";
+    std::cout << "Formateo: " << (double)n / tiempoFormato / 1e6 << " M marcas/s\n";
+    std::cout << "Lectura: " << (double)largo / tiempoLectura / 1e6 << " MB/s, "
+              << (double)n / tiempoLectura / 1e6 << " M marcas/s\n";
+}
+
+/**
+ * @brief Tipos de cubeta para agrupar marcas de tiempo.
+ * 
+ */
+enum TipoCubeta {
+    CUBETA_FIJA,   ///< Intervalos de un ancho fijo en segundos, alineados al 01/01/1970 00:00:00.
+    CUBETA_MES,    ///< Meses calendario.
+    CUBETA_ANIO    ///< Años calendario.
+};
+
+/**
+ * @brief Asigna cada FechaHora a una cubeta fija o calendario en tiempo constante.
+ * 
+ */
+class Cubeteo {
+    private:
+    TipoCubeta tipo;
+    int64_t    ancho;
+
+    constexpr Cubeteo(TipoCubeta _tipo, int64_t _ancho) : tipo(_tipo), ancho(_ancho) {}
+
+    public:
+    /**
+     * @brief Cubetas de un ancho fijo en segundos (por ejemplo 300 para 5 minutos).
+     * 
+     * @param segundos 
+     * @return Cubeteo 
+     */
+    static constexpr Cubeteo porSegundos(int64_t segundos) {
+        return segundos > 0 ? Cubeteo(CUBETA_FIJA, segundos) : throw std::invalid_argument("Ancho de cubeta invalido");
+    }
+    static constexpr Cubeteo porHora() { return Cubeteo(CUBETA_FIJA, 3600); }
+    static constexpr Cubeteo porDia()  { return Cubeteo(CUBETA_FIJA, 86400); }
+    static constexpr Cubeteo porMes()  { return Cubeteo(CUBETA_MES, 1); }
+    static constexpr Cubeteo porAnio() { return Cubeteo(CUBETA_ANIO, 1); }
+
+    /**
+     * @brief Devuelve el indice de la cubeta que contiene una marca de tiempo.
+     * 
+     * @param fh 
+     * @return int64_t 
+     */
+    constexpr int64_t indice(const FechaHora& fh) const {
+        if (tipo == CUBETA_MES) {
+            return (int64_t)fh.getAnio() * 12 + fh.getMes() - 1;
+        }
+        if (tipo == CUBETA_ANIO) {
+            return fh.getAnio();
+        }
+        int64_t s = fh.segundosEpoca();
+        int64_t i = s / ancho;
+        return (s % ancho < 0) ? i - 1 : i;
+    }
+
+    /**
+     * @brief Devuelve el instante en que comienza una cubeta.
+     * 
+     * @param i 
+     * @return FechaHora 
+     */
+    constexpr FechaHora inicio(int64_t i) const {
+        if (tipo == CUBETA_MES) {
+            int64_t anio = i >= 0 ? i / 12 : (i - 11) / 12;
+            return FechaHora(1, (int)(i - anio * 12) + 1, (int)anio, 0, 0, 0);
+        }
+        if (tipo == CUBETA_ANIO) {
+            return FechaHora(1, 1, (int)i, 0, 0, 0);
+        }
+        return FechaHora::desdeSegundosEpoca(i * ancho);
+    }
+};
+
+/**
+ * @brief Cuenta eventos por cubeta de tiempo sobre un rango acotado.
+ * 
+ * Los contadores son un arreglo denso, por lo que contar es un calculo de
+ * indice y un incremento. Para procesar en paralelo cada hilo cuenta en su
+ * propia copia y al final se combinan.
+ */
+class HistogramaTiempo {
+    private:
+    Cubeteo               cubeteo;
+    int64_t               primera;
+    std::vector<uint64_t> conteos;
+    uint64_t              fueraDeRango;
+
+    public:
+    /**
+     * @brief Constructor con el rango cubierto [desde, hasta].
+     * 
+     * @param _cubeteo 
+     * @param desde 
+     * @param hasta 
+     */
+    HistogramaTiempo(Cubeteo _cubeteo, const FechaHora& desde, const FechaHora& hasta)
+        : cubeteo(_cubeteo), primera(_cubeteo.indice(desde)), fueraDeRango(0) {
+        int64_t ultima = cubeteo.indice(hasta);
+        conteos.assign(ultima >= primera ? (size_t)(ultima - primera + 1) : 0, 0);
+    }
+
+    /**
+     * @brief Cuenta un evento.
+     * 
+     * @param fh 
+     */
+    void contar(const FechaHora& fh) {
+        uint64_t i = (uint64_t)(cubeteo.indice(fh) - primera);
+        if (i < conteos.size()) {
+            conteos[i]++;
+        } else {
+            fueraDeRango++;
+        }
+    }
+
+    /**
+     * @brief Suma los conteos de otro histograma con el mismo cubeteo y rango.
+     * 
+     * @param otro 
+     */
+    void combinar(const HistogramaTiempo& otro) {
+        for (size_t i = 0; i < conteos.size() && i < otro.conteos.size(); i++) {
+            conteos[i] += otro.conteos[i];
+        }
+        fueraDeRango += otro.fueraDeRango;
+    }
+
+    /**
+     * @brief Cuenta un vector de eventos en una pasada, repartido en varios hilos.
+     * 
+     * @param datos 
+     * @param hilos 
+     */
+    void contarParalelo(const std::vector<FechaHora>& datos, unsigned hilos) {
+        if (hilos == 0) {
+            hilos = 1;
+        }
+        std::vector<HistogramaTiempo> parciales(hilos, *this);
+        for (HistogramaTiempo& h : parciales) {
+            std::fill(h.conteos.begin(), h.conteos.end(), 0);
+            h.fueraDeRango = 0;
+        }
+        std::vector<std::thread> trabajadores;
+        size_t porHilo = (datos.size() + hilos - 1) / hilos;
+        for (unsigned t = 0; t < hilos; t++) {
+            trabajadores.emplace_back([&, t]() {
+                size_t desde = std::min(datos.size(), t * porHilo);
+                size_t hasta = std::min(datos.size(), desde + porHilo);
+                for (size_t i = desde; i < hasta; i++) {
+                    parciales[t].contar(datos[i]);
+                }
+            });
+        }
+        for (std::thread& t : trabajadores) {
+            t.join();
+        }
+        for (const HistogramaTiempo& h : parciales) {
+            combinar(h);
+        }
+    }
+
+    /**
+     * @brief Devuelve la cantidad de cubetas del rango.
+     * 
+     * @return size_t 
+     */
+    size_t cantidadCubetas() const { return conteos.size(); }
+
+    /**
+     * @brief Devuelve el conteo de una cubeta.
+     * 
+     * @param i 
+     * @return uint64_t 
+     */
+    uint64_t conteo(size_t i) const { return conteos[i]; }
+
+    /**
+     * @brief Devuelve los eventos que cayeron fuera del rango.
+     * 
+     * @return uint64_t 
+     */
+    uint64_t getFueraDeRango() const { return fueraDeRango; }
+
+    /**
+     * @brief Devuelve el instante en que comienza una cubeta.
+     * 
+     * @param i 
+     * @return FechaHora 
+     */
+    FechaHora inicioCubeta(size_t i) const { return cubeteo.inicio(primera + (int64_t)i); }
+};
+
+/**
+ * @brief Mide el conteo por hora de n eventos en uno y en varios hilos.
+ * 
+ * @param n 
+ */
+void compararCubetas(size_t n) {
+    FechaHora desde(1, 1, 2020, 0, 0, 0);
+    FechaHora hasta(31, 12, 2024, 23, 59, 59);
+    std::mt19937_64 generador(13);
+    std::vector<FechaHora> datos;
+    datos.reserve(n);
+    int64_t rango = desde.segundosTranscurridos(hasta) + 1;
+    for (size_t i = 0; i < n; i++) {
+        datos.push_back(desde.sumarSegundos((int64_t)(generador() % (uint64_t)rango)));
+    }
+    unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+
+    HistogramaTiempo secuencial(Cubeteo::porHora(), desde, hasta);
+    auto inicio = std::chrono::steady_clock::now();
+    for (const FechaHora& fh : datos) {
+        secuencial.contar(fh);
+    }
+    double tiempoSecuencial = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    HistogramaTiempo paralelo(Cubeteo::porHora(), desde, hasta);
+    inicio = std::chrono::steady_clock::now();
+    paralelo.contarParalelo(datos, hilos);
+    double tiempoParalelo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    size_t distintos = 0;
+    for (size_t i = 0; i < secuencial.cantidadCubetas(); i++) {
+        distintos += secuencial.conteo(i) != paralelo.conteo(i);
+    }
+    std::cout << "Eventos: " << n << ", cubetas por hora: " << secuencial.cantidadCubetas() << "\n";
+    std::cout << "Un hilo: " << (double)n / tiempoSecuencial / 1e6 << " M eventos/s\n";
+    std::cout << hilos << " hilos: " << (double)n / tiempoParalelo / 1e6 << " M eventos/s\n";
+    std::cout << "Cubetas distintas: " << distintos << "\n";
+}
+
+/**
+ * @brief Intervalo semiabierto [inicio, fin) entre dos FechaHora.
+ * 
+ */
+class IntervaloFechaHora {
+    private:
+    FechaHora inicio;
+    FechaHora fin;
+
+    public:
+    /**
+     * @brief Constructor de IntervaloFechaHora con parametros.
+     * 
+     * @param _inicio 
+     * @param _fin 
+     * @throw std::invalid_argument Si fin es anterior a inicio.
+     */
+    IntervaloFechaHora(const FechaHora& _inicio, const FechaHora& _fin) : inicio(_inicio), fin(_fin) {
+        if (fin < inicio) {
+            throw std::invalid_argument("Intervalo con fin anterior al inicio");
+        }
+    }
+
+    /**
+     * @brief Metodo para accdeder al atributo privado inicio.
+     * 
+     * @return const FechaHora& 
+     */
+    const FechaHora& getInicio() const { return inicio; }
+    /**
+     * @brief Metodo para accdeder al atributo privado fin.
+     * 
+     * @return const FechaHora& 
+     */
+    const FechaHora& getFin()    const { return fin; }
+
+    /**
+     * @brief Indica si el intervalo contiene un instante.
+     * 
+     * @param t 
+     * @return true 
+     * @return false 
+     */
+    bool contiene(const FechaHora& t) const {
+        return inicio <= t && t < fin;
+    }
+
+    /**
+     * @brief Indica si el intervalo se solapa con otro.
+     * 
+     * @param otro 
+     * @return true 
+     * @return false 
+     */
+    bool seSolapa(const IntervaloFechaHora& otro) const {
+        return inicio < otro.fin && otro.inicio < fin;
+    }
+
+    /**
+     * @brief Devuelve la duracion del intervalo en segundos.
+     * 
+     * @return int64_t 
+     */
+    int64_t duracionSegundos() const {
+        return fin.segundosEpoca() - inicio.segundosEpoca();
+    }
+};
+
+/**
+ * @brief Indice estatico de intervalos (arbol de intervalos centrado, guardado en arreglos).
+ * 
+ * Cada nodo guarda un centro y los intervalos que lo contienen, ordenados
+ * por inicio y por fin; los intervalos completamente a la izquierda o a la
+ * derecha del centro bajan a los hijos. La construccion en bloque es
+ * O(n log n) y las consultas de instante o de solapamiento son O(log n + k).
+ * Los resultados son posiciones en el vector usado para construir el indice.
+ */
+class IndiceIntervalos {
+    private:
+    struct Nodo {
+        int64_t  centro;
+        uint32_t desde;      // Rango [desde, hasta) en porInicio y porFin.
+        uint32_t hasta;
+        int32_t  izquierdo;
+        int32_t  derecho;
+    };
+
+    struct Extremo {
+        int64_t  valor;
+        uint32_t id;
+    };
+
+    std::vector<Nodo>    nodos;
+    std::vector<Extremo> porInicio;   // Ascendente por inicio dentro de cada nodo.
+    std::vector<Extremo> porFin;      // Descendente por fin dentro de cada nodo.
+    std::vector<int64_t> inicios;
+    std::vector<int64_t> fines;
+    size_t               cantidad;
+
+    int32_t construir(std::vector<uint32_t>& ids) {
+        if (ids.empty()) {
+            return -1;
+        }
+        std::vector<int64_t> valores(ids.size());
+        for (size_t i = 0; i < ids.size(); i++) {
+            valores[i] = inicios[ids[i]];
+        }
+        std::nth_element(valores.begin(), valores.begin() + valores.size() / 2, valores.end());
+        int64_t centro = valores[valores.size() / 2];
+
+        std::vector<uint32_t> izquierda, derecha;
+        uint32_t desde = (uint32_t)porInicio.size();
+        for (uint32_t id : ids) {
+            if (fines[id] <= centro) {
+                izquierda.push_back(id);
+            } else if (inicios[id] > centro) {
+                derecha.push_back(id);
+            } else {
+                porInicio.push_back({ inicios[id], id });
+                porFin.push_back({ fines[id], id });
+            }
+        }
+        uint32_t hasta = (uint32_t)porInicio.size();
+        std::sort(porInicio.begin() + desde, porInicio.end(),
+                  [](const Extremo& x, const Extremo& y) { return x.valor < y.valor; });
+        std::sort(porFin.begin() + desde, porFin.end(),
+                  [](const Extremo& x, const Extremo& y) { return x.valor > y.valor; });
+        ids.clear();
+        ids.shrink_to_fit();
+
+        int32_t indice = (int32_t)nodos.size();
+        nodos.push_back({ centro, desde, hasta, -1, -1 });
+        int32_t izquierdo = construir(izquierda);
+        int32_t derecho   = construir(derecha);
+        nodos[indice].izquierdo = izquierdo;
+        nodos[indice].derecho   = derecho;
+        return indice;
+    }
+
+    public:
+    /**
+     * @brief Construye el indice en bloque.
+     * 
+     * @param intervalos 
+     */
+    IndiceIntervalos(const std::vector<IntervaloFechaHora>& intervalos) : cantidad(intervalos.size()) {
+        inicios.resize(cantidad);
+        fines.resize(cantidad);
+        std::vector<uint32_t> ids;
+        ids.reserve(cantidad);
+        for (size_t i = 0; i < cantidad; i++) {
+            inicios[i] = intervalos[i].getInicio().segundosEpoca();
+            fines[i]   = intervalos[i].getFin().segundosEpoca();
+            if (inicios[i] < fines[i]) {
+                ids.push_back((uint32_t)i);
+            }
+        }
+        porInicio.reserve(ids.size());
+        porFin.reserve(ids.size());
+        construir(ids);
+    }
+
+    /**
+     * @brief Devuelve la cantidad de intervalos indexados.
+     * 
+     * @return size_t 
+     */
+    size_t tamanio() const { return cantidad; }
+
+    /**
+     * @brief Agrega al resultado los intervalos que contienen el instante t.
+     * 
+     * @param t 
+     * @param resultado 
+     */
+    void enInstante(const FechaHora& t, std::vector<uint32_t>& resultado) const {
+        int64_t s = t.segundosEpoca();
+        int32_t n = nodos.empty() ? -1 : 0;
+        while (n >= 0) {
+            const Nodo& nodo = nodos[n];
+            if (s < nodo.centro) {
+                for (uint32_t i = nodo.desde; i < nodo.hasta && porInicio[i].valor <= s; i++) {
+                    resultado.push_back(porInicio[i].id);
+                }
+                n = nodo.izquierdo;
+            } else {
+                for (uint32_t i = nodo.desde; i < nodo.hasta && porFin[i].valor > s; i++) {
+                    resultado.push_back(porFin[i].id);
+                }
+                n = s > nodo.centro ? nodo.derecho : -1;
+            }
+        }
+    }
+
+    /**
+     * @brief Agrega al resultado los intervalos que se solapan con [desde, hasta).
+     * 
+     * @param desde 
+     * @param hasta 
+     * @param resultado 
+     */
+    void queSolapan(const FechaHora& desde, const FechaHora& hasta, std::vector<uint32_t>& resultado) const {
+        int64_t a = desde.segundosEpoca();
+        int64_t b = hasta.segundosEpoca();
+        if (a >= b || nodos.empty()) {
+            return;
+        }
+        int32_t pila[64];
+        int tope = 0;
+        pila[tope++] = 0;
+        while (tope > 0) {
+            const Nodo& nodo = nodos[pila[--tope]];
+            if (b <= nodo.centro) {
+                for (uint32_t i = nodo.desde; i < nodo.hasta && porInicio[i].valor < b; i++) {
+                    resultado.push_back(porInicio[i].id);
+                }
+                if (nodo.izquierdo >= 0) pila[tope++] = nodo.izquierdo;
+            } else if (a > nodo.centro) {
+                for (uint32_t i = nodo.desde; i < nodo.hasta && porFin[i].valor > a; i++) {
+                    resultado.push_back(porFin[i].id);
+                }
+                if (nodo.derecho >= 0) pila[tope++] = nodo.derecho;
+            } else {
+                for (uint32_t i = nodo.desde; i < nodo.hasta; i++) {
+                    resultado.push_back(porInicio[i].id);
+                }
+                if (nodo.izquierdo >= 0 && a < nodo.centro) pila[tope++] = nodo.izquierdo;
+                if (nodo.derecho >= 0) pila[tope++] = nodo.derecho;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Mide la construccion y las consultas de IndiceIntervalos y las verifica contra una busqueda lineal.
+ * 
+ * @param n 
+ */
+void compararIntervalos(size_t n) {
+    FechaHora base(1, 1, 2020, 0, 0, 0);
+    std::mt19937_64 generador(17);
+    std::vector<IntervaloFechaHora> intervalos;
+    intervalos.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        FechaHora inicio = base.sumarSegundos((int64_t)(generador() % (5ULL * 365 * 86400)));
+        intervalos.emplace_back(inicio, inicio.sumarSegundos((int64_t)(generador() % (8 * 3600))));
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    IndiceIntervalos indice(intervalos);
+    double tiempoConstruccion = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    const size_t consultas = 100000;
+    std::vector<FechaHora> instantes;
+    for (size_t i = 0; i < consultas; i++) {
+        instantes.push_back(base.sumarSegundos((int64_t)(generador() % (5ULL * 365 * 86400))));
+    }
+    std::vector<uint32_t> resultado;
+    size_t encontrados = 0;
+    inicio = std::chrono::steady_clock::now();
+    for (const FechaHora& t : instantes) {
+        resultado.clear();
+        indice.enInstante(t, resultado);
+        encontrados += resultado.size();
+    }
+    double tiempoInstante = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    inicio = std::chrono::steady_clock::now();
+    for (const FechaHora& t : instantes) {
+        resultado.clear();
+        indice.queSolapan(t, t.sumarHoras(1), resultado);
+        encontrados += resultado.size();
+    }
+    double tiempoSolape = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    size_t errores = 0;
+    for (size_t q = 0; q < 20; q++) {
+        IntervaloFechaHora rango(instantes[q], instantes[q].sumarHoras(1));
+        std::vector<uint32_t> esperado, obtenido;
+        for (size_t i = 0; i < n; i++) {
+            if (intervalos[i].seSolapa(rango)) esperado.push_back((uint32_t)i);
+        }
+        indice.queSolapan(rango.getInicio(), rango.getFin(), obtenido);
+        std::sort(obtenido.begin(), obtenido.end());
+        errores += esperado != obtenido;
+        esperado.clear();
+        obtenido.clear();
+        for (size_t i = 0; i < n; i++) {
+            if (intervalos[i].contiene(instantes[q])) esperado.push_back((uint32_t)i);
+        }
+        indice.enInstante(instantes[q], obtenido);
+        std::sort(obtenido.begin(), obtenido.end());
+        errores += esperado != obtenido;
+    }
+
+    std::cout << "Intervalos: " << n << ", construccion: " << tiempoConstruccion << " s\n";
+    std::cout << "Consultas de instante: " << (double)consultas / tiempoInstante / 1e3 << " mil/s\n";
+    std::cout << "Consultas de solapamiento (1 hora): " << (double)consultas / tiempoSolape / 1e3 << " mil/s\n";
+    std::cout << "Resultados: " << encontrados << ", consultas con error: " << errores << "\n";
+}
+
+/**
+ * @brief Dias de la semana segun ISO-8601 (lunes = 1, domingo = 7).
+ * 
+ */
+enum DiaSemana {
+    LUNES = 1,
+    MARTES,
+    MIERCOLES,
+    JUEVES,
+    VIERNES,
+    SABADO,
+    DOMINGO
+};
+
+/**
+ * @brief Devuelve el bit de un dia de la semana para armar mascaras (por ejemplo bitDia(LUNES) | bitDia(JUEVES)).
+ * 
+ * @param d 
+ * @return constexpr unsigned 
+ */
+constexpr unsigned bitDia(DiaSemana d) { return 1u << d; }
+
+/**
+ * @brief Mascara de lunes a viernes.
+ * 
+ */
+constexpr unsigned MASCARA_HABILES = bitDia(LUNES) | bitDia(MARTES) | bitDia(MIERCOLES) | bitDia(JUEVES) | bitDia(VIERNES);
+
+/**
+ * @brief Frecuencia de una recurrencia.
+ * 
+ */
+enum Frecuencia {
+    DIARIA,
+    SEMANAL,
+    MENSUAL,
+    ANUAL
+};
+
+/**
+ * @brief Secuencia perezosa de fechas generada por una regla de recurrencia.
+ * 
+ * Se recorre con un for de rango y no reserva memoria; cada paso es O(1)
+ * sobre dias seriales. Los metodos de configuracion devuelven una copia
+ * modificada, por lo que se pueden encadenar sobre un temporal. Las fechas
+ * se materializan solo con materializar().
+ * 
+ * - DIARIA: cada 'intervalo' dias, filtrando por la mascara de dias (0 = todos).
+ * - SEMANAL: cada 'intervalo' semanas (de lunes a domingo), los dias de la mascara
+ *   (0 = el dia de la semana de inicio).
+ * - MENSUAL: cada 'intervalo' meses, el mismo dia del mes que inicio (se omiten los
+ *   meses sin ese dia), o con ordinal el n-esimo dia de la mascara en el mes
+ *   (1 = primero, -1 = ultimo).
+ * - ANUAL: cada 'intervalo' años, el mismo dia y mes que inicio.
+ * 
+ * Si una regla no produce fechas en 1000 periodos seguidos la secuencia termina.
+ */
+class Recurrencia {
+    private:
+    Fecha      inicio;
+    Frecuencia frecuencia;
+    int        intervalo;
+    unsigned   mascara;
+    int        ordinal;
+    int        serialHasta;
+    size_t     maximo;
+
+    static constexpr int MAX_PERIODOS_VACIOS = 1000;
+
+    /**
+     * @brief Calcula las fechas (seriales, en orden) de un periodo; devuelve cuantas son.
+     * 
+     */
+    int candidatos(int64_t periodo, int (&salida)[7]) const {
+        int n = 0;
+        int64_t paso = periodo * intervalo;
+        if (frecuencia == DIARIA) {
+            int serial = inicio.diaSerial() + (int)paso;
+            if (mascara == 0 || (mascara & (1u << Fecha::desdeSerial(serial).diaSemana()))) {
+                salida[n++] = serial;
+            }
+        } else if (frecuencia == SEMANAL) {
+            int lunes = inicio.diaSerial() - (inicio.diaSemana() - 1) + (int)paso * 7;
+            unsigned dias = mascara != 0 ? mascara : (1u << inicio.diaSemana());
+            for (int d = LUNES; d <= DOMINGO; d++) {
+                if (dias & (1u << d)) {
+                    salida[n++] = lunes + d - 1;
+                }
+            }
+        } else if (frecuencia == MENSUAL) {
+            int64_t mesAbsoluto = (int64_t)inicio.getAnio() * 12 + inicio.getMes() - 1 + paso;
+            int anio = (int)(mesAbsoluto >= 0 ? mesAbsoluto / 12 : (mesAbsoluto - 11) / 12);
+            int mes  = (int)(mesAbsoluto - (int64_t)anio * 12) + 1;
+            if (ordinal == 0) {
+                if (inicio.getDia() <= Fecha::diasEnMes(mes, anio)) {
+                    salida[n++] = Fecha::serialDesdeCivil(inicio.getDia(), mes, anio);
+                }
+            } else {
+                int primero = Fecha::serialDesdeCivil(1, mes, anio);
+                int ultimo  = primero + Fecha::diasEnMes(mes, anio) - 1;
+                int semanaPrimero = Fecha::desdeSerial(primero).diaSemana();
+                int semanaUltimo  = Fecha::desdeSerial(ultimo).diaSemana();
+                unsigned dias = mascara != 0 ? mascara : (1u << inicio.diaSemana());
+                for (int d = LUNES; d <= DOMINGO; d++) {
+                    if (!(dias & (1u << d))) {
+                        continue;
+                    }
+                    int serial = ordinal > 0 ? primero + (d - semanaPrimero + 7) % 7 + (ordinal - 1) * 7
+                                             : ultimo - (semanaUltimo - d + 7) % 7 + (ordinal + 1) * 7;
+                    if (serial >= primero && serial <= ultimo) {
+                        salida[n++] = serial;
+                    }
+                }
+                std::sort(salida, salida + n);
+            }
+        } else {
+            int anio = inicio.getAnio() + (int)paso;
+            if (inicio.getDia() <= Fecha::diasEnMes(inicio.getMes(), anio)) {
+                salida[n++] = Fecha::serialDesdeCivil(inicio.getDia(), inicio.getMes(), anio);
+            }
+        }
+        return n;
+    }
+
+    public:
+    /**
+     * @brief Constructor de Recurrencia; por defecto sin fin.
+     * 
+     * @param _inicio 
+     * @param _frecuencia 
+     * @param _intervalo 
+     */
+    Recurrencia(const Fecha& _inicio, Frecuencia _frecuencia, int _intervalo = 1)
+        : inicio(_inicio), frecuencia(_frecuencia), intervalo(_intervalo), mascara(0), ordinal(0),
+          serialHasta(INT32_MAX), maximo(SIZE_MAX) {
+        if (intervalo < 1) {
+            throw std::invalid_argument("Intervalo de recurrencia invalido");
+        }
+    }
+
+    /**
+     * @brief Limita la secuencia a los dias de una mascara (bitDia / MASCARA_HABILES).
+     * 
+     * @param _mascara 
+     * @return Recurrencia 
+     */
+    Recurrencia dias(unsigned _mascara) const { Recurrencia r = *this; r.mascara = _mascara; return r; }
+
+    /**
+     * @brief En reglas mensuales, toma el n-esimo dia de la mascara en cada mes (negativo cuenta desde el final).
+     * 
+     * @param _ordinal 
+     * @return Recurrencia 
+     */
+    Recurrencia enOrdinal(int _ordinal) const { Recurrencia r = *this; r.ordinal = _ordinal; return r; }
+
+    /**
+     * @brief Termina la secuencia en una fecha (incluida).
+     * 
+     * @param fin 
+     * @return Recurrencia 
+     */
+    Recurrencia hasta(const Fecha& fin) const { Recurrencia r = *this; r.serialHasta = fin.diaSerial(); return r; }
+
+    /**
+     * @brief Termina la secuencia despues de una cantidad de fechas.
+     * 
+     * @param cantidad 
+     * @return Recurrencia 
+     */
+    Recurrencia limite(size_t cantidad) const { Recurrencia r = *this; r.maximo = cantidad; return r; }
+
+    /**
+     * @brief Iterador de entrada sobre las fechas de la recurrencia.
+     * 
+     */
+    class Iterador {
+        private:
+        const Recurrencia* regla;
+        int64_t periodo;
+        int     fechas[7];
+        int     cantidad;
+        int     posicion;
+        size_t  entregadas;
+        bool    terminado;
+
+        void avanzar() {
+            if (entregadas >= regla->maximo) {
+                terminado = true;
+                return;
+            }
+            posicion++;
+            int vacios = 0;
+            while (true) {
+                while (posicion < cantidad) {
+                    int serial = fechas[posicion];
+                    if (serial > regla->serialHasta) {
+                        terminado = true;
+                        return;
+                    }
+                    if (serial >= regla->inicio.diaSerial()) {
+                        return;
+                    }
+                    posicion++;
+                }
+                if (++vacios > MAX_PERIODOS_VACIOS) {
+                    terminado = true;
+                    return;
+                }
+                periodo++;
+                cantidad = regla->candidatos(periodo, fechas);
+                posicion = 0;
+            }
+        }
+
+        public:
+        Iterador(const Recurrencia* _regla, bool fin)
+            : regla(_regla), periodo(0), cantidad(0), posicion(-1), entregadas(0), terminado(fin) {
+            if (!terminado) {
+                cantidad = regla->candidatos(0, fechas);
+                avanzar();
+            }
+        }
+
+        Fecha operator*() const { return Fecha::desdeSerial(fechas[posicion]); }
+
+        Iterador& operator++() {
+            entregadas++;
+            avanzar();
+            return *this;
+        }
+
+        bool operator!=(const Iterador& otro) const { return terminado != otro.terminado; }
+        bool operator==(const Iterador& otro) const { return terminado == otro.terminado; }
+    };
+
+    Iterador begin() const { return Iterador(this, false); }
+    Iterador end()   const { return Iterador(this, true); }
+
+    /**
+     * @brief Genera todas las fechas de la secuencia (requiere hasta() o limite()).
+     * 
+     * @return std::vector<Fecha> 
+     */
+    std::vector<Fecha> materializar() const {
+        std::vector<Fecha> resultado;
+        for (const Fecha& f : *this) {
+            resultado.push_back(f);
+        }
+        return resultado;
+    }
+
+    /**
+     * @brief Dias habiles (lunes a viernes) entre dos fechas, incluidas.
+     * 
+     * @param desde 
+     * @param hasta 
+     * @return Recurrencia 
+     */
+    static Recurrencia diasHabiles(const Fecha& desde, const Fecha& hasta) {
+        return Recurrencia(desde, DIARIA).dias(MASCARA_HABILES).hasta(hasta);
+    }
+};
+
+/**
+ * @brief Reloj de baja resolucion para marcar eventos en rutas calientes.
+ * 
+ * Un hilo de fondo consulta el reloj del sistema cada 'resolucion' y publica
+ * el FechaHora actual empaquetado (FechaHoraCompacta) en un entero atomico y
+ * su texto ISO-8601 en un anillo de buffers. Los lectores hacen una sola carga
+ * atomica, sin bloqueos ni llamadas al sistema.
+ */
+class RelojCache {
+    private:
+    static constexpr uint32_t BUFFERS_TEXTO = 8;
+
+    std::atomic<uint64_t> compacta;
+    std::atomic<int64_t>  milisegundos;
+    std::atomic<uint32_t> indiceTexto;
+    char                  textos[BUFFERS_TEXTO][LARGO_MAX_FORMATO];
+    std::atomic<bool>     activo;
+    std::chrono::milliseconds resolucion;
+    std::thread           hilo;
+
+    void refrescar() {
+        timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        int64_t ms = (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+        FechaHora fh = FechaHora::desdeSegundosEpoca((int64_t)ts.tv_sec);
+        uint64_t valor = FechaHoraCompacta(fh).getValor();
+        if (valor != compacta.load(std::memory_order_relaxed)) {
+            uint32_t siguiente = (indiceTexto.load(std::memory_order_relaxed) + 1) % BUFFERS_TEXTO;
+            *fh.escribirISO8601(textos[siguiente]) = '\0';
+            indiceTexto.store(siguiente, std::memory_order_release);
+            compacta.store(valor, std::memory_order_release);
+        }
+        milisegundos.store(ms, std::memory_order_release);
+    }
+
+    public:
+    /**
+     * @brief Constructor; publica la hora actual e inicia el hilo de refresco.
+     * 
+     * @param _resolucion 
+     */
+    explicit RelojCache(std::chrono::milliseconds _resolucion = std::chrono::milliseconds(10))
+        : compacta(0), milisegundos(0), indiceTexto(0), activo(true), resolucion(_resolucion) {
+        textos[0][0] = '\0';
+        refrescar();
+        hilo = std::thread([this]() {
+            while (activo.load(std::memory_order_relaxed)) {
+                std::this_thread::sleep_for(resolucion);
+                refrescar();
+            }
+        });
+    }
+
+    RelojCache(const RelojCache&) = delete;
+    RelojCache& operator=(const RelojCache&) = delete;
+
+    /**
+     * @brief Destructor; detiene el hilo de refresco.
+     * 
+     */
+    ~RelojCache() {
+        activo.store(false);
+        hilo.join();
+    }
+
+    /**
+     * @brief Devuelve el FechaHora (UTC) publicado mas reciente.
+     * 
+     * @return FechaHora 
+     */
+    FechaHora ahora() const {
+        return FechaHoraCompacta::desdeValor(compacta.load(std::memory_order_acquire)).aFechaHora();
+    }
+
+    /**
+     * @brief Devuelve los milisegundos desde el 01/01/1970 publicados mas recientes.
+     * 
+     * @return int64_t 
+     */
+    int64_t ahoraMilisegundos() const {
+        return milisegundos.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Devuelve el texto ISO-8601 publicado mas reciente.
+     * 
+     * El puntero sigue siendo valido durante al menos BUFFERS_TEXTO - 1 cambios de segundo.
+     * 
+     * @return const char* 
+     */
+    const char* texto() const {
+        return textos[indiceTexto.load(std::memory_order_acquire)];
+    }
+
+    /**
+     * @brief Reloj compartido por el proceso, con resolucion de 10 ms.
+     * 
+     * @return RelojCache& 
+     */
+    static RelojCache& global() {
+        static RelojCache reloj;
+        return reloj;
+    }
+};
+
+/**
+ * @brief Mide el costo por llamada de RelojCache::ahora contra FechaHora::ahora.
+ * 
+ * @param n 
+ */
+void compararReloj(size_t n) {
+    RelojCache& reloj = RelojCache::global();
+    int64_t suma = 0;
+
+    auto inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; i++) {
+        suma += FechaHora::ahora().getSegundo();
+    }
+    double tiempoDirecto = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    inicio = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < n; i++) {
+        suma += reloj.ahora().getSegundo();
+    }
+    double tiempoCache = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::cout << "Llamadas: " << n << " (control " << suma % 10 << ")\n";
+    std::cout << "FechaHora::ahora: " << tiempoDirecto / (double)n * 1e9 << " ns por llamada\n";
+    std::cout << "RelojCache::ahora: " << tiempoCache / (double)n * 1e9 << " ns por llamada\n";
+    std::cout << "Texto actual: " << reloj.texto() << "\n";
+}
+
+/**
  * @brief Muestra un mensaje y datos de un objeto Fecha.
  * 
  * @param msg 
@@ -387,6 +2835,15 @@ void mostrar(const std::string& msg, const FechaHora& t) {
     std::cout << msg << ": " << t.retornarFecha() << " " << t.retornarTiempo() << "\n";
 }
 
+// Fechas constantes: se validan y calculan durante la compilacion.
+constexpr Fecha     navidad2024  = Fecha::crear(25, 12, 2024);
+constexpr FechaHora anioNuevo2025 = FechaHora::crear(1, 1, 2025, 0, 0, 0);
+static_assert(navidad2024.diasTranscurridos(anioNuevo2025) == 7, "diasTranscurridos");
+static_assert(anioNuevo2025.restarSegundos(1).getAnio() == 2024, "restarSegundos");
+static_assert(Fecha::diasEnMes(2, 2024) == 29 && Fecha::diasEnMes(2, 1900) == 28, "diasEnMes");
+static_assert(FechaHoraCompacta(anioNuevo2025).aFechaHora() == anioNuevo2025, "FechaHoraCompacta");
+static_assert(FechaHoraCompacta(anioNuevo2025.restarSegundos(1)) < FechaHoraCompacta(anioNuevo2025), "FechaHoraCompacta");
+
 void pruebas(){
     // Ejemplo de definiciones
     Fecha f0 = Fecha(21,10, 2024);
@@ -406,6 +2863,27 @@ void pruebas(){
     mostrar("fh0", fh0);
     mostrar("fh1", fh1);
     mostrar("fh2", fh2);
+    // Representacion compacta
+    FechaHoraCompacta c2(fh2);
+    std::cout << "fh2 compacta: " << sizeof(c2) << " bytes, valor " << c2.getValor() << "\n";
+    mostrar("fh2 desde compacta", c2.aFechaHora());
+    // Formato ISO-8601 y lectura
+    char iso[LARGO_MAX_FORMATO];
+    std::string textoIso(iso, fh0.escribirISO8601(iso));
+    FechaHora leida(1, 1, 1970, 0, 0, 0);
+    FechaHora::leerISO8601(textoIso.data(), textoIso.data() + textoIso.size(), leida);
+    std::cout << "fh0 ISO-8601: " << textoIso << "\n";
+    mostrar("fh0 leida desde ISO-8601", leida);
+    // Zonas horarias
+    try {
+        const ZonaHoraria& santiago = ZonaHoraria::cargar("America/Santiago");
+        FechaHora localFh0 = santiago.aLocal(fh0);
+        mostrar("fh0 (UTC) en " + santiago.getNombre(), localFh0);
+        mostrar("fh0 de vuelta a UTC", santiago.aUTC(localFh0));
+    } catch (const std::runtime_error& e) {
+        std::cout << "Error: " << e.what() << "\n";
+    }
+    mostrar("fh0 en " + ZonaHoraria::fija(5 * 3600 + 1800).getNombre(), ZonaHoraria::fija(5 * 3600 + 1800).aLocal(fh0));
 
     std::cout << "\n";
 
@@ -415,6 +2893,10 @@ void pruebas(){
     // Restar Dias
     FechaHora fh6 = fh2.restarDias(4);
     mostrar("fh2 - 4 dias", fh6);
+    // Sumar y restar muchos dias
+    FechaHora fh9 = fh2.sumarDias(100000);
+    mostrar("fh2 + 100000 dias", fh9);
+    mostrar("fh2 + 100000 dias - 100000 dias", fh9.restarDias(100000));
 
     std::cout << "\n";
     
@@ -428,6 +2910,18 @@ void pruebas(){
     std::cout << "Diferencia de dia entre fh0 y fh1: "
               << fh0.diferenciaDias(fh1) << " dia" << "\n";
     
+    // Tiempo transcurrido real
+    Duracion d0 = fh0.duracionCalendario(fh1);
+    std::cout << "Dias transcurridos entre fh0 y fh1: "
+              << fh0.diasTranscurridos(fh1) << " dias" << "\n";
+    std::cout << "Segundos transcurridos entre fh0 y fh1: "
+              << fh0.segundosTranscurridos(fh1) << " segundos" << "\n";
+    std::cout << "Duracion entre fh0 y fh1: " << d0.anios << " años, " << d0.meses << " meses, "
+              << d0.dias << " dias, " << d0.horas << " horas, " << d0.minutos << " minutos, "
+              << d0.segundos << " segundos" << "\n";
+    std::cout << "Dias transcurridos entre 31/1/2024 y 1/2/2024: "
+              << Fecha(31, 1, 2024).diasTranscurridos(Fecha(1, 2, 2024)) << " dia" << "\n";
+
     std::cout << "\n";
     
     // Sumar Horas
@@ -436,6 +2930,10 @@ void pruebas(){
     // Restar Horas
     FechaHora fh7 = fh2.restarHoras(48);
     mostrar("fh2 - 48 horas", fh7);
+    // Sumar muchas horas, minutos y segundos
+    mostrar("fh2 + 1000000 horas", fh2.sumarHoras(1000000));
+    mostrar("fh2 + 90 minutos", fh2.sumarMinutos(90));
+    mostrar("fh2 - 3661 segundos", fh2.restarSegundos(3661));
 
     std::cout << "\n";
 
@@ -460,6 +2958,35 @@ void pruebas(){
 
     std::cout << "\n";
 
+    // Conteo por mes
+    HistogramaTiempo porMes(Cubeteo::porMes(), FechaHora(1, 1, 1996, 0, 0, 0), FechaHora(31, 3, 1996, 0, 0, 0));
+    for (const FechaHora& fh : { fh1, fh2, fh3, fh5, fh6, fh7 }) {
+        porMes.contar(fh);
+    }
+    for (size_t i = 0; i < porMes.cantidadCubetas(); i++) {
+        std::cout << "Eventos en " << porMes.inicioCubeta(i).retornarFecha() << ": " << porMes.conteo(i) << "\n";
+    }
+
+    std::cout << "\n";
+
+    // Recurrencias
+    size_t habiles2025 = Recurrencia::diasHabiles(Fecha(1, 1, 2025), Fecha(31, 12, 2025)).materializar().size();
+    std::cout << "Dias habiles en 2025: " << habiles2025 << "\n";
+    std::cout << "Primer lunes de cada mes desde f0:";
+    for (const Fecha& f : Recurrencia(f0, MENSUAL).dias(bitDia(LUNES)).enOrdinal(1).limite(4)) {
+        std::cout << " " << f.retornarFecha();
+    }
+    std::cout << "\n";
+
+    std::cout << "\n";
+
+    // Comparar orden cronologico
+    if (fh0 < fh1) {
+        std::cout << "fh0 es anterior a fh1" << "\n";
+    }
+
+    std::cout << "\n";
+
     // Comprobar que f0 es igual a f1
     if (f0 == f1) {
         std::cout << "f0 es igual a f1" << "\n";
@@ -475,6 +3002,23 @@ void pruebas(){
 }
 
 int main(int argc, char* argv[]){
-    pruebas();
+    std::string modo = argc >= 2 ? argv[1] : "";
+    if (modo == "benchmark-orden") {
+        compararOrdenamiento(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+    } else if (modo == "benchmark-lote") {
+        compararLote(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+    } else if (modo == "benchmark-parseo") {
+        compararParseo(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+    } else if (modo == "benchmark-cubetas") {
+        compararCubetas(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+    } else if (modo == "benchmark-intervalos") {
+        compararIntervalos(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 1000000);
+    } else if (modo == "benchmark-reloj") {
+        compararReloj(argc >= 3 ? std::strtoull(argv[2], nullptr, 10) : 10000000);
+    } else if (modo == "parsear-log" && argc >= 3) {
+        return procesarArchivoMarcas(argv[2]) ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else {
+        pruebas();
+    }
     return(EXIT_SUCCESS);
 }
\ No newline at end of file
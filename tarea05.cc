@@ -2,6 +2,24 @@
 #include <string>
 #include <cstdlib>
 #include <stdexcept>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <unordered_map>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include <poll.h>
 
 /**
  * @file tarea05_doxygen.cc
@@ -257,6 +275,360 @@ class Persona {
     }
 };
 
+/********************************************
+ * Instrumentación de DB                    *
+ * Se desactiva compilando con              *
+ * -DDB_INSTRUMENTACION=0                   *
+ ********************************************/
+#ifndef DB_INSTRUMENTACION
+#define DB_INSTRUMENTACION 1
+#endif
+
+/**
+ * @enum OperacionDB
+ * @brief Operaciones de la clase DB que se miden.
+ */
+enum OperacionDB {
+    OP_ADD = 0,
+    OP_MOSTRAR_REGISTROS,
+    OP_SELECCIONAR_PAIS,
+    OP_SELECCIONAR_CIUDAD,
+    OP_SELECCIONAR_APELLIDO,
+    OP_SELECCIONAR_NOMBRE,
+    OP_BUSCAR,
+    OP_TOTAL
+};
+
+/**
+ * @brief Nombre de una operación, usado en los reportes.
+ * @param op Operación.
+ * @return Nombre de la operación.
+ */
+inline const char* nombreOperacion(int op) {
+    static const char* nombres[OP_TOTAL] = {
+        "add", "mostrarRegistros", "seleccionarPaisOrigen",
+        "seleccionarCiudadResidencia", "seleccionarApellido", "seleccionarNombre",
+        "buscar"
+    };
+    return nombres[op];
+}
+
+#if DB_INSTRUMENTACION
+
+/**
+ * @class HistogramaLatencia
+ * @brief Cubetas log-lineales (estilo HDR) para latencias en nanosegundos.
+ *
+ * Los valores menores a 16 ns tienen una cubeta cada uno; sobre eso cada
+ * potencia de dos se divide en 16 sub-cubetas, con un error relativo
+ * máximo de 1/16.
+ */
+class HistogramaLatencia {
+    public:
+    static const int BITS_SUB   = 4;
+    static const int SUB        = 1 << BITS_SUB;
+    static const int CUBETAS    = (64 - BITS_SUB + 1) * SUB;
+
+    /**
+     * @brief Obtiene la cubeta de un valor.
+     * @param ns Latencia en nanosegundos.
+     * @return Índice de la cubeta.
+     */
+    static int indice(uint64_t ns) {
+        if (ns < (uint64_t)SUB) {
+            return (int)ns;
+        }
+        int exponente = 63 - __builtin_clzll(ns);
+        int corrimiento = exponente - BITS_SUB;
+        int sub = (int)((ns >> corrimiento) & (SUB - 1));
+        return (corrimiento + 1) * SUB + sub;
+    }
+
+    /**
+     * @brief Valor mínimo que cae en una cubeta.
+     * @param i Índice de la cubeta.
+     * @return Límite inferior en nanosegundos.
+     */
+    static uint64_t limiteInferior(int i) {
+        if (i < SUB) {
+            return (uint64_t)i;
+        }
+        int corrimiento = i / SUB - 1;
+        return ((uint64_t)(SUB + i % SUB)) << corrimiento;
+    }
+
+    /**
+     * @brief Valor representativo de una cubeta (punto medio).
+     * @param i Índice de la cubeta.
+     * @return Latencia en nanosegundos.
+     */
+    static uint64_t valorMedio(int i) {
+        if (i < SUB) {
+            return (uint64_t)i;
+        }
+        int corrimiento = i / SUB - 1;
+        return limiteInferior(i) + ((((uint64_t)1) << corrimiento) >> 1);
+    }
+};
+
+/**
+ * @struct ContadoresHilo
+ * @brief Contadores de un hilo. Solo el hilo dueño escribe; los lectores
+ *        leen con cargas relajadas y suman todos los hilos.
+ */
+struct ContadoresHilo {
+    std::atomic<uint64_t> llamadas[OP_TOTAL];
+    std::atomic<uint64_t> filasLeidas[OP_TOTAL];
+    std::atomic<uint64_t> filasDevueltas[OP_TOTAL];
+    std::atomic<uint64_t> nsTotal[OP_TOTAL];
+    std::atomic<uint64_t> cubetas[OP_TOTAL][HistogramaLatencia::CUBETAS];
+};
+
+/**
+ * @brief Suma a un contador que solo escribe el hilo dueño (sin instrucción lock).
+ * @param c Contador.
+ * @param v Valor a sumar.
+ */
+inline void sumarLocal(std::atomic<uint64_t>& c, uint64_t v) {
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+}
+
+/**
+ * @struct ResumenOperacion
+ * @brief Contadores de una operación sumados sobre todos los hilos.
+ */
+struct ResumenOperacion {
+    uint64_t llamadas       = 0;
+    uint64_t filasLeidas    = 0;
+    uint64_t filasDevueltas = 0;
+    uint64_t nsTotal        = 0;
+    std::vector<uint64_t> cubetas = std::vector<uint64_t>(HistogramaLatencia::CUBETAS, 0);
+
+    /**
+     * @brief Percentil de latencia.
+     * @param p Percentil entre 0 y 100.
+     * @return Latencia en nanosegundos.
+     */
+    uint64_t percentil(double p) const {
+        if (llamadas == 0) {
+            return 0;
+        }
+        uint64_t objetivo = (uint64_t)(p / 100.0 * (double)llamadas + 0.5);
+        if (objetivo == 0) {
+            objetivo = 1;
+        }
+        uint64_t acumulado = 0;
+        for (int i = 0; i < HistogramaLatencia::CUBETAS; i++) {
+            acumulado += cubetas[i];
+            if (acumulado >= objetivo) {
+                return HistogramaLatencia::valorMedio(i);
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Latencia máxima observada (resolución de cubeta).
+     * @return Latencia en nanosegundos.
+     */
+    uint64_t maximo() const {
+        for (int i = HistogramaLatencia::CUBETAS - 1; i >= 0; i--) {
+            if (cubetas[i] != 0) {
+                return HistogramaLatencia::valorMedio(i);
+            }
+        }
+        return 0;
+    }
+};
+
+/**
+ * @class EstadisticasDB
+ * @brief Registro global de contadores por hilo y generación de reportes.
+ */
+class EstadisticasDB {
+    private:
+    static std::mutex& mutexRegistro() {
+        static std::mutex m;
+        return m;
+    }
+
+    static std::vector<std::unique_ptr<ContadoresHilo>>& registro() {
+        static std::vector<std::unique_ptr<ContadoresHilo>> hilos;
+        return hilos;
+    }
+
+    static ContadoresHilo* registrarHilo() {
+        std::lock_guard<std::mutex> lock(mutexRegistro());
+        registro().emplace_back(new ContadoresHilo());
+        return registro().back().get();
+    }
+
+    public:
+    /**
+     * @brief Contadores del hilo actual. El registro se hace una sola vez por hilo.
+     * @return Contadores del hilo.
+     */
+    static ContadoresHilo& local() {
+        thread_local ContadoresHilo* contadores = registrarHilo();
+        return *contadores;
+    }
+
+    /**
+     * @brief Suma los contadores de todos los hilos para una operación.
+     * @param op Operación.
+     * @return Resumen de la operación.
+     */
+    static ResumenOperacion resumen(int op) {
+        ResumenOperacion r;
+        std::lock_guard<std::mutex> lock(mutexRegistro());
+        for (auto& h : registro()) {
+            r.llamadas       += h->llamadas[op].load(std::memory_order_relaxed);
+            r.filasLeidas    += h->filasLeidas[op].load(std::memory_order_relaxed);
+            r.filasDevueltas += h->filasDevueltas[op].load(std::memory_order_relaxed);
+            r.nsTotal        += h->nsTotal[op].load(std::memory_order_relaxed);
+            for (int i = 0; i < HistogramaLatencia::CUBETAS; i++) {
+                r.cubetas[i] += h->cubetas[op][i].load(std::memory_order_relaxed);
+            }
+        }
+        return r;
+    }
+
+    /**
+     * @brief Reporte legible de todas las operaciones.
+     * @return Cadena con una línea por operación.
+     */
+    static std::string reporteTexto() {
+        std::string s;
+        for (int op = 0; op < OP_TOTAL; op++) {
+            ResumenOperacion r = resumen(op);
+            uint64_t media = r.llamadas ? r.nsTotal / r.llamadas : 0;
+            s += std::string(nombreOperacion(op)) + ": llamadas=" + std::to_string(r.llamadas)
+               + " leidas=" + std::to_string(r.filasLeidas)
+               + " devueltas=" + std::to_string(r.filasDevueltas)
+               + " media=" + std::to_string(media) + "ns"
+               + " p50=" + std::to_string(r.percentil(50)) + "ns"
+               + " p90=" + std::to_string(r.percentil(90)) + "ns"
+               + " p99=" + std::to_string(r.percentil(99)) + "ns"
+               + " max=" + std::to_string(r.maximo()) + "ns\n";
+        }
+        return s;
+    }
+
+    /**
+     * @brief Reporte en formato JSON de todas las operaciones.
+     * @return Cadena JSON.
+     */
+    static std::string reporteJSON() {
+        std::string s = "{\"operaciones\":[";
+        for (int op = 0; op < OP_TOTAL; op++) {
+            ResumenOperacion r = resumen(op);
+            uint64_t media = r.llamadas ? r.nsTotal / r.llamadas : 0;
+            if (op > 0) {
+                s += ",";
+            }
+            s += "{\"nombre\":\"" + std::string(nombreOperacion(op)) + "\""
+               + ",\"llamadas\":" + std::to_string(r.llamadas)
+               + ",\"filas_leidas\":" + std::to_string(r.filasLeidas)
+               + ",\"filas_devueltas\":" + std::to_string(r.filasDevueltas)
+               + ",\"latencia_ns\":{\"media\":" + std::to_string(media)
+               + ",\"p50\":" + std::to_string(r.percentil(50))
+               + ",\"p90\":" + std::to_string(r.percentil(90))
+               + ",\"p99\":" + std::to_string(r.percentil(99))
+               + ",\"max\":" + std::to_string(r.maximo()) + "}}";
+        }
+        s += "]}";
+        return s;
+    }
+};
+
+/**
+ * @class MedicionDB
+ * @brief Mide una llamada a una operación de DB (RAII). Al destruirse
+ *        registra la latencia y las filas en los contadores del hilo.
+ */
+class MedicionDB {
+    private:
+    int op;
+    std::chrono::steady_clock::time_point inicio;
+    uint64_t leidas;
+    uint64_t devueltas;
+
+    public:
+    /**
+     * @brief Inicia la medición.
+     * @param _op Operación medida.
+     */
+    MedicionDB(int _op) {
+        op        = _op;
+        leidas    = 0;
+        devueltas = 0;
+        inicio    = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Registra filas recorridas por la operación.
+     * @param n Cantidad de filas.
+     */
+    void filasLeidas(uint64_t n) { leidas += n; }
+
+    /**
+     * @brief Registra una fila que cumple el filtro.
+     */
+    void filaDevuelta() { devueltas++; }
+
+    /**
+     * @brief Termina la medición y la acumula en el hilo actual.
+     */
+    ~MedicionDB() {
+        uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - inicio).count();
+        ContadoresHilo& c = EstadisticasDB::local();
+        sumarLocal(c.llamadas[op], 1);
+        sumarLocal(c.filasLeidas[op], leidas);
+        sumarLocal(c.filasDevueltas[op], devueltas);
+        sumarLocal(c.nsTotal[op], ns);
+        sumarLocal(c.cubetas[op][HistogramaLatencia::indice(ns)], 1);
+    }
+};
+
+#else
+
+/**
+ * @class EstadisticasDB
+ * @brief Versión vacía cuando la instrumentación está desactivada.
+ */
+class EstadisticasDB {
+    public:
+    static std::string reporteTexto() { return "Instrumentación deshabilitada\n"; }
+    static std::string reporteJSON()  { return "{\"operaciones\":[]}"; }
+};
+
+/**
+ * @class MedicionDB
+ * @brief Versión vacía cuando la instrumentación está desactivada; el
+ *        compilador elimina todas las llamadas.
+ */
+class MedicionDB {
+    public:
+    MedicionDB(int) {}
+    void filasLeidas(uint64_t) {}
+    void filaDevuelta() {}
+};
+
+#endif
+
+/**
+ * @enum CampoDB
+ * @brief Campos de Persona por los que se puede filtrar en DB::buscar.
+ */
+enum CampoDB {
+    CAMPO_PAIS = 0,
+    CAMPO_CIUDAD,
+    CAMPO_APELLIDO,
+    CAMPO_NOMBRE,
+    CAMPO_TOTAL
+};
+
 /**
  * @class DB
  * @brief Clase que representa una base de datos de personas.
@@ -297,6 +669,7 @@ class DB {
      * @throw DBaddException Si se intenta agregar más personas de las permitidas.
      */
     void add(Persona& persona) {
+        MedicionDB medicion(OP_ADD);
         if (last >= size) {
             throw DBaddException("Índice fuera de rango.");
         }
@@ -309,9 +682,12 @@ class DB {
      * @brief Método para mostrar los registros de todas las personas.
      */
     void mostrarRegistros() {
+        MedicionDB medicion(OP_MOSTRAR_REGISTROS);
         for (int i = 0; i < last; i++) {
             std::cout << "Registro " << i << ": " << personas[i].toString() << "\n";
+            medicion.filaDevuelta();
         }
+        medicion.filasLeidas(last);
     }
 
     /**
@@ -319,12 +695,15 @@ class DB {
      * @param pais País de origen a filtrar.
      */
     void seleccionarPaisOrigen(const std::string& pais) {
+        MedicionDB medicion(OP_SELECCIONAR_PAIS);
         std::cout << "Personas de origen: " << pais << "\n";
         for (int i = 0; i < last; i++) {
             if (personas[i].getPaisOrigen() == pais) {
                 std::cout << personas[i].toString() << "\n";
+                medicion.filaDevuelta();
             }
         }
+        medicion.filasLeidas(last);
     }
 
     /**
@@ -332,12 +711,15 @@ class DB {
      * @param ciudad Ciudad de residencia a filtrar.
      */
     void seleccionarCiudadResidencia(const std::string& ciudad) {
+        MedicionDB medicion(OP_SELECCIONAR_CIUDAD);
         std::cout << "Personas en la ciudad: " << ciudad << "\n";
         for (int i = 0; i < last; i++) {
             if (personas[i].getCiudad() == ciudad) {
                 std::cout << personas[i].toString() << "\n";
+                medicion.filaDevuelta();
             }
         }
+        medicion.filasLeidas(last);
     }
 
     /**
@@ -345,12 +727,15 @@ class DB {
      * @param apellido Apellido a filtrar.
      */
     void seleccionarApellido(const std::string& apellido) {
+        MedicionDB medicion(OP_SELECCIONAR_APELLIDO);
         std::cout << "Personas con apellido: " << apellido << "\n";
         for (int i = 0; i < last; i++) {
             if (personas[i].getApellido1() == apellido) {
                 std::cout << personas[i].toString() << "\n";
+                medicion.filaDevuelta();
             }
         }
+        medicion.filasLeidas(last);
     }
 
     /**
@@ -358,12 +743,57 @@ class DB {
      * @param nombre Nombre a filtrar.
      */
     void seleccionarNombre(const std::string& nombre) {
+        MedicionDB medicion(OP_SELECCIONAR_NOMBRE);
         std::cout << "Personas con nombre: " << nombre << "\n";
         for (int i = 0; i < last; i++) {
             if (personas[i].getNombre() == nombre) {
                 std::cout << personas[i].toString() << "\n";
+                medicion.filaDevuelta();
             }
         }
+        medicion.filasLeidas(last);
+    }
+
+    /**
+     * @brief Busca los registros cuyo campo coincide con un valor, sin imprimir.
+     * @param campo Campo a comparar.
+     * @param valor Valor buscado.
+     * @param resultado Índices de los registros que coinciden (se agregan al final).
+     */
+    void buscar(CampoDB campo, const std::string& valor, std::vector<int>& resultado) {
+        MedicionDB medicion(OP_BUSCAR);
+        for (int i = 0; i < last; i++) {
+            bool coincide = false;
+            switch (campo) {
+                case CAMPO_PAIS:     coincide = personas[i].getPaisOrigen() == valor; break;
+                case CAMPO_CIUDAD:   coincide = personas[i].getCiudad() == valor;     break;
+                case CAMPO_APELLIDO: coincide = personas[i].getApellido1() == valor;  break;
+                case CAMPO_NOMBRE:   coincide = personas[i].getNombre() == valor;     break;
+                default: break;
+            }
+            if (coincide) {
+                resultado.push_back(i);
+                medicion.filaDevuelta();
+            }
+        }
+        medicion.filasLeidas(last);
+    }
+
+    /**
+     * @brief Obtiene un registro por su índice.
+     * @param i Índice del registro.
+     * @return Referencia a la persona.
+     */
+    Persona& registro(int i) {
+        return personas[i];
+    }
+
+    /**
+     * @brief Obtiene la cantidad de registros cargados.
+     * @return Cantidad de registros.
+     */
+    int cantidad() const {
+        return last;
     }
 };
 
@@ -378,6 +808,564 @@ class DB {
  */
 void cargarDatos(DB& baseDatos);
 
+/********************************************
+ * Servicio de consultas por socket Unix    *
+ ********************************************/
+
+/**
+ * @class ServidorDBException
+ * @brief Clase de excepción para errores del servidor o cliente de consultas.
+ */
+class ServidorDBException : public std::exception {
+    private:
+    std::string msg;
+
+    public:
+    /**
+     * @brief Constructor de la excepción; agrega la descripción de errno.
+     * @param m Mensaje de error.
+     */
+    ServidorDBException(std::string m){
+        msg = m + ": " + std::strerror(errno);
+    }
+    /**
+     * @brief Constructor de la excepción para errores que no vienen de una llamada al sistema.
+     * @param m Mensaje de error.
+     * @param conErrno Si es false, no agrega la descripción de errno.
+     */
+    ServidorDBException(std::string m, bool conErrno){
+        msg = conErrno ? m + ": " + std::strerror(errno) : m;
+    }
+    /**
+     * @brief Método que devuelve el mensaje de error.
+     * @return Mensaje de error.
+     */
+    const char* what() const noexcept override {
+        return(msg.c_str());
+    }
+};
+
+/**
+ * @enum OperacionProtocolo
+ * @brief Operaciones del protocolo binario.
+ *
+ * Cada trama es [u32 largo][cuerpo], con enteros en el orden de bytes de la
+ * máquina (el socket es local).
+ * Solicitud: [u32 id][u8 operacion][u8 campo][valor ...].
+ * Respuesta: [u32 id][u8 estado][u32 cantidad][datos ...].
+ */
+enum OperacionProtocolo {
+    PROTO_SELECCIONAR   = 1, ///< datos: cantidad x ([u16 largo][Persona::toString()])
+    PROTO_CONTAR        = 2, ///< sin datos, solo cantidad
+    PROTO_EDAD_PROMEDIO = 3, ///< datos: double con la edad promedio
+    PROTO_ESTADISTICAS  = 4  ///< datos: EstadisticasDB::reporteJSON()
+};
+
+/**
+ * @enum EstadoProtocolo
+ * @brief Estado de una respuesta.
+ */
+enum EstadoProtocolo {
+    PROTO_OK    = 0,
+    PROTO_ERROR = 1
+};
+
+const uint32_t PROTO_MAX_TRAMA     = 64 * 1024;        ///< Largo máximo de una solicitud.
+const size_t   PROTO_MAX_PENDIENTE = 4 * 1024 * 1024;  ///< Salida pendiente antes de dejar de leer.
+
+/**
+ * @brief Agrega un entero de 32 bits al final de un buffer.
+ * @param buf Buffer.
+ * @param v Valor.
+ */
+inline void escribirU32(std::string& buf, uint32_t v) {
+    buf.append((const char*)&v, sizeof(v));
+}
+
+/**
+ * @brief Lee un entero de 32 bits desde memoria sin alinear.
+ * @param p Puntero a los datos.
+ * @return Valor leído.
+ */
+inline uint32_t leerU32(const char* p) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @struct ConexionDB
+ * @brief Estado de una conexión del servidor.
+ */
+struct ConexionDB {
+    std::string entrada;          ///< Bytes recibidos sin procesar.
+    std::string salida;           ///< Respuestas pendientes de enviar.
+    size_t      enviado = 0;      ///< Bytes de salida ya escritos.
+    uint32_t    eventos = 0;      ///< Eventos epoll registrados.
+};
+
+volatile std::sig_atomic_t servidorActivo = 1;
+
+/**
+ * @brief Manejador de SIGINT/SIGTERM para detener el servidor.
+ */
+extern "C" void detenerServidor(int) {
+    servidorActivo = 0;
+}
+
+/**
+ * @class ServidorDB
+ * @brief Servidor de consultas sobre una DB, con un ciclo epoll de un hilo.
+ *
+ * Cada lectura procesa todas las solicitudes completas que haya en el buffer
+ * (pipelining) y las respuestas se acumulan para enviarlas con una sola
+ * escritura.
+ */
+class ServidorDB {
+    private:
+    DB&                                 baseDatos;
+    std::string                         ruta;
+    int                                 fdEscucha;
+    int                                 fdEpoll;
+    int                                 fdReserva;
+    std::unordered_map<int, ConexionDB> conexiones;
+    std::vector<int>                    indices;
+
+    void registrarEventos(int fd, ConexionDB& c, uint32_t eventos) {
+        if (c.eventos == eventos) {
+            return;
+        }
+        epoll_event ev{};
+        ev.events  = eventos;
+        ev.data.fd = fd;
+        epoll_ctl(fdEpoll, EPOLL_CTL_MOD, fd, &ev);
+        c.eventos = eventos;
+    }
+
+    void cerrar(int fd) {
+        epoll_ctl(fdEpoll, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        conexiones.erase(fd);
+    }
+
+    /**
+     * @brief Acepta todas las conexiones pendientes.
+     *
+     * Si se agotan los descriptores (EMFILE/ENFILE) se libera el descriptor de
+     * reserva para aceptar la conexión y cerrarla de inmediato; de lo contrario
+     * el socket de escucha seguiría listo y epoll no dejaría de notificarlo.
+     */
+    void aceptar() {
+        while (true) {
+            int fd = accept4(fdEscucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                if (errno == EMFILE || errno == ENFILE) {
+                    int error = errno;
+                    if (fdReserva >= 0) {
+                        close(fdReserva);
+                        int rechazada = accept(fdEscucha, nullptr, nullptr);
+                        if (rechazada >= 0) {
+                            std::cerr << "accept4: " << std::strerror(error) << ", se rechaza una conexión\n";
+                            close(rechazada);
+                        }
+                        fdReserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                        if (rechazada >= 0) {
+                            continue;
+                        }
+                    }
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    std::cerr << "accept4: " << std::strerror(errno) << "\n";
+                }
+                return;
+            }
+            epoll_event ev{};
+            ev.events  = EPOLLIN;
+            ev.data.fd = fd;
+            epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fd, &ev);
+            conexiones[fd].eventos = EPOLLIN;
+        }
+    }
+
+    void responder(const char* cuerpo, uint32_t largo, std::string& salida) {
+        size_t inicio = salida.size();
+        escribirU32(salida, 0);
+        if (largo < 6) {
+            escribirU32(salida, 0);
+            salida.push_back((char)PROTO_ERROR);
+            escribirU32(salida, 0);
+        } else {
+            uint32_t id    = leerU32(cuerpo);
+            uint8_t  op    = (uint8_t)cuerpo[4];
+            uint8_t  campo = (uint8_t)cuerpo[5];
+            std::string valor(cuerpo + 6, largo - 6);
+
+            escribirU32(salida, id);
+            if (op != PROTO_ESTADISTICAS && campo >= CAMPO_TOTAL) {
+                salida.push_back((char)PROTO_ERROR);
+                escribirU32(salida, 0);
+            } else if (op == PROTO_ESTADISTICAS) {
+                salida.push_back((char)PROTO_OK);
+                escribirU32(salida, 0);
+                salida += EstadisticasDB::reporteJSON();
+            } else {
+                indices.clear();
+                baseDatos.buscar((CampoDB)campo, valor, indices);
+                if (op == PROTO_CONTAR) {
+                    salida.push_back((char)PROTO_OK);
+                    escribirU32(salida, (uint32_t)indices.size());
+                } else if (op == PROTO_EDAD_PROMEDIO) {
+                    double suma = 0;
+                    for (int i : indices) {
+                        suma += baseDatos.registro(i).getEdad();
+                    }
+                    double promedio = indices.empty() ? 0.0 : suma / (double)indices.size();
+                    salida.push_back((char)PROTO_OK);
+                    escribirU32(salida, (uint32_t)indices.size());
+                    salida.append((const char*)&promedio, sizeof(promedio));
+                } else if (op == PROTO_SELECCIONAR) {
+                    salida.push_back((char)PROTO_OK);
+                    escribirU32(salida, (uint32_t)indices.size());
+                    for (int i : indices) {
+                        std::string fila = baseDatos.registro(i).toString();
+                        uint16_t n = (uint16_t)std::min<size_t>(fila.size(), 0xFFFF);
+                        salida.append((const char*)&n, sizeof(n));
+                        salida.append(fila.data(), n);
+                    }
+                } else {
+                    salida.push_back((char)PROTO_ERROR);
+                    escribirU32(salida, 0);
+                }
+            }
+        }
+        uint32_t total = (uint32_t)(salida.size() - inicio - 4);
+        std::memcpy(&salida[inicio], &total, sizeof(total));
+    }
+
+    bool leer(int fd, ConexionDB& c) {
+        char buf[64 * 1024];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+            return false;
+        }
+        if (n > 0) {
+            c.entrada.append(buf, (size_t)n);
+        }
+        size_t pos = 0;
+        while (c.entrada.size() - pos >= 4) {
+            uint32_t largo = leerU32(c.entrada.data() + pos);
+            if (largo > PROTO_MAX_TRAMA) {
+                return false;
+            }
+            if (c.entrada.size() - pos - 4 < largo) {
+                break;
+            }
+            responder(c.entrada.data() + pos + 4, largo, c.salida);
+            pos += 4 + largo;
+        }
+        c.entrada.erase(0, pos);
+        return true;
+    }
+
+    bool escribir(int fd, ConexionDB& c) {
+        while (c.enviado < c.salida.size()) {
+            ssize_t n = write(fd, c.salida.data() + c.enviado, c.salida.size() - c.enviado);
+            if (n < 0) {
+                if (errno == EAGAIN) {
+                    break;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            c.enviado += (size_t)n;
+        }
+        size_t pendiente = c.salida.size() - c.enviado;
+        if (pendiente == 0) {
+            c.salida.clear();
+            c.enviado = 0;
+            registrarEventos(fd, c, EPOLLIN);
+        } else if (pendiente > PROTO_MAX_PENDIENTE) {
+            registrarEventos(fd, c, EPOLLOUT);
+        } else {
+            registrarEventos(fd, c, EPOLLIN | EPOLLOUT);
+        }
+        return true;
+    }
+
+    public:
+    /**
+     * @brief Constructor; crea el socket de escucha y la instancia epoll.
+     * @param _baseDatos Base de datos que se consulta.
+     * @param _ruta Ruta del socket Unix.
+     * @throw ServidorDBException Si no se puede crear o enlazar el socket.
+     */
+    ServidorDB(DB& _baseDatos, std::string _ruta): baseDatos(_baseDatos) {
+        ruta = _ruta;
+        sockaddr_un dir{};
+        if (ruta.size() >= sizeof(dir.sun_path)) {
+            errno = ENAMETOOLONG;
+            throw ServidorDBException("Ruta de socket demasiado larga");
+        }
+        dir.sun_family = AF_UNIX;
+        std::strcpy(dir.sun_path, ruta.c_str());
+
+        fdEscucha = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fdEscucha < 0) {
+            throw ServidorDBException("socket");
+        }
+        unlink(ruta.c_str());
+        if (bind(fdEscucha, (sockaddr*)&dir, sizeof(dir)) < 0 || listen(fdEscucha, 128) < 0) {
+            close(fdEscucha);
+            throw ServidorDBException("No se pudo escuchar en " + ruta);
+        }
+        fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+        if (fdEpoll < 0) {
+            close(fdEscucha);
+            throw ServidorDBException("epoll_create1");
+        }
+        epoll_event ev{};
+        ev.events  = EPOLLIN;
+        ev.data.fd = fdEscucha;
+        epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fdEscucha, &ev);
+        fdReserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    }
+
+    /**
+     * @brief Destructor; cierra las conexiones y elimina el socket.
+     */
+    ~ServidorDB() {
+        for (auto& par : conexiones) {
+            close(par.first);
+        }
+        if (fdReserva >= 0) {
+            close(fdReserva);
+        }
+        close(fdEpoll);
+        close(fdEscucha);
+        unlink(ruta.c_str());
+    }
+
+    /**
+     * @brief Atiende conexiones hasta recibir SIGINT o SIGTERM.
+     */
+    void ejecutar() {
+        epoll_event eventos[256];
+        while (servidorActivo) {
+            int n = epoll_wait(fdEpoll, eventos, 256, 1000);
+            for (int i = 0; i < n; i++) {
+                int fd = eventos[i].data.fd;
+                if (fd == fdEscucha) {
+                    aceptar();
+                    continue;
+                }
+                auto it = conexiones.find(fd);
+                if (it == conexiones.end()) {
+                    continue;
+                }
+                ConexionDB& c = it->second;
+                bool ok = true;
+                if (eventos[i].events & (EPOLLERR | EPOLLHUP)) {
+                    ok = (eventos[i].events & EPOLLIN) != 0;
+                }
+                if (ok && (eventos[i].events & EPOLLIN)) {
+                    ok = leer(fd, c);
+                }
+                if (ok) {
+                    ok = escribir(fd, c);
+                }
+                if (!ok) {
+                    cerrar(fd);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Agrega una solicitud al final de un buffer.
+ * @param buf Buffer.
+ * @param id Identificador de la solicitud.
+ * @param op Operación.
+ * @param campo Campo a filtrar.
+ * @param valor Valor buscado.
+ */
+inline void escribirSolicitud(std::string& buf, uint32_t id, uint8_t op, uint8_t campo, const std::string& valor) {
+    escribirU32(buf, (uint32_t)(6 + valor.size()));
+    escribirU32(buf, id);
+    buf.push_back((char)op);
+    buf.push_back((char)campo);
+    buf += valor;
+}
+
+/**
+ * @brief Conecta un socket no bloqueante al servidor.
+ * @param ruta Ruta del socket Unix.
+ * @return Descriptor conectado.
+ * @throw ServidorDBException Si no se puede conectar.
+ */
+inline int conectarServidor(const std::string& ruta) {
+    sockaddr_un dir{};
+    dir.sun_family = AF_UNIX;
+    std::strncpy(dir.sun_path, ruta.c_str(), sizeof(dir.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, (sockaddr*)&dir, sizeof(dir)) < 0 || fcntl(fd, F_SETFL, O_NONBLOCK) < 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw ServidorDBException("No se pudo conectar a " + ruta);
+    }
+    return fd;
+}
+
+/**
+ * @brief Genera carga sobre una conexión manteniendo varias solicitudes en vuelo.
+ *
+ * El socket es no bloqueante y se espera con poll, de modo que el envío y la
+ * lectura de respuestas se intercalan: aunque el servidor deje de leer porque
+ * tiene demasiada salida pendiente, el cliente sigue consumiendo respuestas.
+ *
+ * @param ruta Ruta del socket Unix.
+ * @param total Solicitudes a enviar.
+ * @param profundidad Máximo de solicitudes sin respuesta.
+ * @param latencias Latencias medidas en nanosegundos (se agregan al final).
+ */
+inline void generarCarga(const std::string& ruta, int total, int profundidad, std::vector<uint64_t>& latencias) {
+    static const std::string valores[CAMPO_TOTAL] = { "Perú", "Rancagua", "Garcia", "Carla" };
+    static const uint8_t     ops[3] = { PROTO_CONTAR, PROTO_EDAD_PROMEDIO, PROTO_SELECCIONAR };
+
+    int fd = conectarServidor(ruta);
+    std::vector<std::chrono::steady_clock::time_point> envio(total);
+    std::string salida;
+    size_t escrito = 0;
+    std::string entrada;
+    char buf[64 * 1024];
+    int enviadas = 0;
+    int recibidas = 0;
+
+    while (recibidas < total) {
+        while (enviadas < total && enviadas - recibidas < profundidad) {
+            int campo = enviadas % CAMPO_TOTAL;
+            escribirSolicitud(salida, (uint32_t)enviadas, ops[enviadas % 3], (uint8_t)campo, valores[campo]);
+            envio[enviadas] = std::chrono::steady_clock::now();
+            enviadas++;
+        }
+
+        pollfd pfd{};
+        pfd.fd     = fd;
+        pfd.events = POLLIN | (escrito < salida.size() ? POLLOUT : 0);
+        if (poll(&pfd, 1, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close(fd);
+            throw ServidorDBException("poll");
+        }
+
+        if (pfd.revents & POLLOUT) {
+            while (escrito < salida.size()) {
+                ssize_t n = write(fd, salida.data() + escrito, salida.size() - escrito);
+                if (n < 0) {
+                    if (errno == EAGAIN || errno == EINTR) {
+                        break;
+                    }
+                    close(fd);
+                    throw ServidorDBException("write");
+                }
+                escrito += (size_t)n;
+            }
+            if (escrito == salida.size()) {
+                salida.clear();
+                escrito = 0;
+            }
+        }
+
+        if (pfd.revents & (POLLIN | POLLHUP | POLLERR)) {
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+                continue;
+            }
+            if (n < 0) {
+                close(fd);
+                throw ServidorDBException("read");
+            }
+            if (n == 0) {
+                close(fd);
+                throw ServidorDBException("Conexión cerrada por el servidor", false);
+            }
+            entrada.append(buf, (size_t)n);
+            size_t pos = 0;
+            auto ahora = std::chrono::steady_clock::now();
+            while (entrada.size() - pos >= 4) {
+                uint32_t largo = leerU32(entrada.data() + pos);
+                if (entrada.size() - pos - 4 < largo) {
+                    break;
+                }
+                uint32_t id = leerU32(entrada.data() + pos + 4);
+                if (id < (uint32_t)total) {
+                    latencias.push_back((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                            ahora - envio[id]).count());
+                }
+                recibidas++;
+                pos += 4 + largo;
+            }
+            entrada.erase(0, pos);
+        }
+    }
+    close(fd);
+}
+
+/**
+ * @brief Cliente generador de carga; imprime QPS y percentiles de latencia.
+ * @param ruta Ruta del socket Unix.
+ * @param conexiones Cantidad de conexiones (un hilo por conexión).
+ * @param solicitudes Solicitudes por conexión.
+ * @param profundidad Solicitudes en vuelo por conexión.
+ */
+void clienteCarga(const std::string& ruta, int conexiones, int solicitudes, int profundidad) {
+    std::vector<std::vector<uint64_t>> latencias(conexiones);
+    std::vector<std::thread> hilos;
+    std::vector<std::string> errores(conexiones);
+
+    auto inicio = std::chrono::steady_clock::now();
+    for (int i = 0; i < conexiones; i++) {
+        hilos.emplace_back([&, i]() {
+            try {
+                generarCarga(ruta, solicitudes, profundidad, latencias[i]);
+            } catch (const ServidorDBException& e) {
+                errores[i] = e.what();
+            }
+        });
+    }
+    for (auto& h : hilos) {
+        h.join();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::vector<uint64_t> todas;
+    for (int i = 0; i < conexiones; i++) {
+        if (!errores[i].empty()) {
+            std::cout << "Error en conexión " << i << ": " << errores[i] << "\n";
+        }
+        todas.insert(todas.end(), latencias[i].begin(), latencias[i].end());
+    }
+    if (todas.empty()) {
+        return;
+    }
+    std::sort(todas.begin(), todas.end());
+    auto percentil = [&](double p) {
+        size_t i = (size_t)(p / 100.0 * (double)(todas.size() - 1));
+        return todas[i] / 1000.0;
+    };
+    std::cout << "Solicitudes: " << todas.size() << " en " << segundos << " s\n";
+    std::cout << "QPS: " << (double)todas.size() / segundos << "\n";
+    std::cout << "Latencia p50: " << percentil(50) << " us, p99: " << percentil(99)
+              << " us, max: " << todas.back() / 1000.0 << " us\n";
+}
+
 /**
  * @brief Función de pruebas para demostrar el uso de las clases.
  */
@@ -413,16 +1401,52 @@ void pruebas(){
     baseDatos.seleccionarApellido("Garcia");
     std::cout << "***** Seleccionar por nombre *****\n";
     baseDatos.seleccionarNombre("Carla");
+    std::cout << "***** Estadísticas de DB *****\n";
+    std::cout << EstadisticasDB::reporteTexto();
+    std::cout << EstadisticasDB::reporteJSON() << "\n";
 }
 
 /**
  * @brief Función principal del programa.
+ *
+ * Sin argumentos ejecuta pruebas(). Además acepta:
+ *  - servidor <socket>: atiende consultas sobre una DB cargada con cargarDatos().
+ *  - cliente <socket> [conexiones] [solicitudes] [profundidad]: genera carga.
+ *
  * @param argc Número de argumentos.
  * @param argv Arreglo de argumentos.
  * @return Código de salida del programa.
  */
 int main(int argc, char* argv[]){
-    pruebas();
+    std::string modo = argc >= 3 ? argv[1] : "";
+    try {
+        if (modo == "servidor") {
+            DB baseDatos(130);
+            cargarDatos(baseDatos);
+            std::signal(SIGINT, detenerServidor);
+            std::signal(SIGTERM, detenerServidor);
+            std::signal(SIGPIPE, SIG_IGN);
+            ServidorDB servidor(baseDatos, argv[2]);
+            servidor.ejecutar();
+            std::cout << EstadisticasDB::reporteTexto();
+        } else if (modo == "cliente") {
+            int conexiones  = argc > 3 ? std::atoi(argv[3]) : 4;
+            int solicitudes = argc > 4 ? std::atoi(argv[4]) : 100000;
+            int profundidad = argc > 5 ? std::atoi(argv[5]) : 32;
+            if (conexiones <= 0 || solicitudes <= 0 || profundidad <= 0) {
+                std::cout << "Uso: " << argv[0] << " cliente <socket> [conexiones] [solicitudes] [profundidad]\n"
+                          << "     conexiones, solicitudes y profundidad deben ser mayores que 0\n";
+                return(EXIT_FAILURE);
+            }
+            std::signal(SIGPIPE, SIG_IGN);
+            clienteCarga(argv[2], conexiones, solicitudes, profundidad);
+        } else {
+            pruebas();
+        }
+    } catch (const ServidorDBException& e) {
+        std::cout << "Error: " << e.what() << "\n";
+        return(EXIT_FAILURE);
+    }
     return(EXIT_SUCCESS);
 }
 